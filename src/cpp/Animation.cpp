@@ -2,7 +2,7 @@
 #include <utility>
 
 Animation::Animation(
-    SDL_Texture* spritesheet,
+    SpriteSheet spritesheet,
     std::vector<std::tuple<int, int>> frames,
     Vector2D<int> const& sprite_offset,
     int framesize_x,
@@ -26,7 +26,7 @@ void Animation::set_on_finish_animation_callback(std::function<void()> const& f)
 }
 
 void Animation::run(
-    SDL_Renderer* renderer,
+    DrawList& draw_list,
     double elapsedTime,
     int face,
     Vector2D<int> const& world_position,
@@ -52,5 +52,57 @@ void Animation::run(
     auto size = Vector2D<int> { this->framesize_x, this->framesize_y };
     auto flip = (face == +1) ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
     auto draw_position = world_position - this->sprite_offset;
-    draw_sprite(renderer, this->spritesheet, offset, draw_position, size, camera_offset, flip);
+    draw_sprite(draw_list, this->spritesheet, offset, draw_position, size, camera_offset, flip);
+}
+
+FrameAnimation::FrameAnimation(
+    SpriteSheet spritesheet,
+    std::span<std::tuple<int, int> const> frames,
+    Vector2D<int> const& sprite_offset,
+    int framesize_x,
+    int framesize_y,
+    double animation_time,
+    bool loop
+)
+    : spritesheet(spritesheet)
+    , frames(frames)
+    , sprite_offset(sprite_offset)
+    , framesize_x(framesize_x)
+    , framesize_y(framesize_y)
+    , animation_time(animation_time)
+    , loop(loop)
+    , state(0)
+    , counter(0)
+{
+}
+
+bool FrameAnimation::run(
+    DrawList& draw_list,
+    double elapsedTime,
+    int face,
+    Vector2D<int> const& world_position,
+    Vector2D<int> const& camera_offset)
+{
+    if (this->state >= this->frames.size()) {
+        return false;
+    }
+    this->counter += elapsedTime;
+    if (this->counter >= this->animation_time) {
+        this->counter = 0.0;
+        this->state += 1;
+        if (this->state == this->frames.size()) {
+            if (!this->loop) {
+                return false;
+            }
+            this->state = 0;
+        }
+    }
+    auto const& [frame_x, frame_y] = this->frames[this->state];
+
+    auto offset = Vector2D<int> { frame_x * this->framesize_x, frame_y * this->framesize_y };
+    auto size = Vector2D<int> { this->framesize_x, this->framesize_y };
+    auto flip = (face == +1) ? SDL_FLIP_NONE : SDL_FLIP_HORIZONTAL;
+    auto draw_position = world_position - this->sprite_offset;
+    draw_sprite(draw_list, this->spritesheet, offset, draw_position, size, camera_offset, flip);
+    return true;
 }
@@ -9,12 +9,14 @@
 #include <drawing.hpp>
 #include <functional>
 #include <optional>
+#include <span>
+#include <tuple>
 #include <vector>
 
 class Animation {
 public:
     Animation(
-        SDL_Texture* spritesheet,
+        SpriteSheet spritesheet,
         std::vector<std::tuple<int, int>> frames,
         Vector2D<int> const& sprite_offset,
         int framesize_x,
@@ -24,7 +26,7 @@ public:
 
     void set_on_finish_animation_callback(std::function<void()> const& f);
     void run(
-        SDL_Renderer* renderer,
+        DrawList& draw_list,
         double elapsedTime,
         int face,
         Vector2D<int> const& world_position,
@@ -32,7 +34,7 @@ public:
     );
 
 public:
-    SDL_Texture* spritesheet;
+    SpriteSheet spritesheet;
     std::vector<std::tuple<int, int>> frames;
     Vector2D<int> sprite_offset;
     int framesize_x;
@@ -43,4 +45,40 @@ public:
     std::optional<std::function<void()>> on_finish_animation;
 };
 
+// Animation of the pooled objects (projectiles, one-shot effects), created without allocating: its frames live in
+// static storage, and instead of a finish callback, run() tells when a one-shot animation is over.
+class FrameAnimation {
+public:
+    FrameAnimation(
+        SpriteSheet spritesheet,
+        std::span<std::tuple<int, int> const> frames,
+        Vector2D<int> const& sprite_offset,
+        int framesize_x,
+        int framesize_y,
+        double animation_time,
+        bool loop
+    );
+
+    // Advances the animation and draws its current frame. Returns false, drawing nothing, once a one-shot animation
+    // is over.
+    bool run(
+        DrawList& draw_list,
+        double elapsedTime,
+        int face,
+        Vector2D<int> const& world_position,
+        Vector2D<int> const& camera_offset
+    );
+
+public:
+    SpriteSheet spritesheet;
+    std::span<std::tuple<int, int> const> frames;
+    Vector2D<int> sprite_offset;
+    int framesize_x;
+    int framesize_y;
+    double animation_time;
+    bool loop;
+    std::size_t state;
+    double counter;
+};
+
 #endif
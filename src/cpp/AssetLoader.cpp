@@ -0,0 +1,87 @@
+#include <AssetLoader.hpp>
+#include <AssetPack.hpp>
+#include <SDL_image.h>
+#include <logging.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double milliseconds_since(Clock::time_point const& start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Runs decode(filename) for every file on a pool of worker threads, keeping the results in order
+    template <typename T>
+    std::vector<T*> parallel_decode(std::string const& kind, std::vector<std::string> const& filenames,
+        std::function<T*(std::string const&)> const& decode)
+    {
+        auto start = Clock::now();
+        auto results = std::vector<T*>(filenames.size(), nullptr);
+
+        auto next = std::atomic<std::size_t>(0);
+        auto worker = [&]() {
+            for (auto i = next++; i < filenames.size(); i = next++) {
+                results[i] = decode(filenames[i]);
+            }
+        };
+
+        auto n_threads = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), filenames.size());
+        auto threads = std::vector<std::thread>();
+        for (std::size_t i = 1; i < n_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        info("Decoded "s + std::to_string(filenames.size()) + " "s + kind + " in "s
+            + std::to_string(milliseconds_since(start)) + " ms ("s + std::to_string(n_threads) + " threads)"s);
+        return results;
+    }
+}
+
+std::vector<SDL_Surface*> decode_images(std::vector<std::string> const& filenames)
+{
+    return parallel_decode<SDL_Surface>("images", filenames, [](std::string const& filename) -> SDL_Surface* {
+        if (auto entry = asset_pack.find_image(filename)) {
+            auto* pixels = const_cast<std::byte*>(entry->data.data());
+            return SDL_CreateRGBSurfaceWithFormatFrom(pixels, entry->width, entry->height, 32, 4 * entry->width,
+                SDL_PIXELFORMAT_RGBA32);
+        }
+
+        auto* surface = IMG_Load(filename.c_str());
+        if (surface == nullptr) {
+            warn("Unable to load image (filename="s + filename + "): "s + IMG_GetError());
+            return nullptr;
+        }
+        auto* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(surface);
+        if (converted == nullptr) {
+            warn("Unable to convert image (filename="s + filename + "): "s + SDL_GetError());
+        }
+        return converted;
+    });
+}
+
+std::vector<Mix_Chunk*> decode_sounds(std::vector<std::string> const& filenames)
+{
+    return parallel_decode<Mix_Chunk>("sounds", filenames, [](std::string const& filename) -> Mix_Chunk* {
+        auto* sound = static_cast<Mix_Chunk*>(nullptr);
+        if (auto entry = asset_pack.find(filename)) {
+            sound = Mix_LoadWAV_RW(SDL_RWFromConstMem(entry->data.data(), static_cast<int>(entry->data.size())), 1);
+        } else {
+            sound = Mix_LoadWAV(filename.c_str());
+        }
+        if (!sound) {
+            warn("Unable to load sound (filename="s + filename + ": "s + Mix_GetError());
+        }
+        return sound;
+    });
+}
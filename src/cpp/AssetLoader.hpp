@@ -0,0 +1,23 @@
+#ifndef PIGSGAME_ASSETLOADER_HPP
+#define PIGSGAME_ASSETLOADER_HPP
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include <string>
+#include <vector>
+
+// Decoding of asset files on a pool of worker threads. Only CPU-side data is produced (surfaces and sound
+// chunks): creating textures from the decoded surfaces is left to the caller, on the render thread.
+// Per-asset and total decoding times are reported on the standard output.
+
+// Images are decoded and converted to SDL_PIXELFORMAT_RGBA32. Files that fail to load yield nullptr. Images
+// found in the asset pack are not decoded at all: the surface points straight to the mapped pixels, so it must be
+// freed before the pack is closed.
+std::vector<SDL_Surface*> decode_images(std::vector<std::string> const& filenames);
+
+// Sound effects are fully decoded into chunks, from the asset pack when available. Files that fail to load yield
+// nullptr.
+std::vector<Mix_Chunk*> decode_sounds(std::vector<std::string> const& filenames);
+
+#endif //PIGSGAME_ASSETLOADER_HPP
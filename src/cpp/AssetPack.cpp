@@ -0,0 +1,98 @@
+#include <AssetPack.hpp>
+#include <logging.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace asset_pack_format;
+
+AssetPack::AssetPack()
+    : file()
+    , entries()
+{
+}
+
+AssetPack::~AssetPack()
+{
+    this->close();
+}
+
+bool AssetPack::open(std::string const& filename)
+{
+    this->close();
+
+    if (!this->file.open(filename)) {
+        return false;
+    }
+    auto data = this->file.data();
+    auto size = data.size();
+    if (size < sizeof(Header)) {
+        warn("Invalid asset pack (filename="s + filename + ")"s);
+        this->close();
+        return false;
+    }
+
+    auto header = Header {};
+    std::memcpy(&header, data.data(), sizeof(Header));
+    auto toc_end = sizeof(Header) + std::size_t(header.entry_count) * sizeof(TocEntry);
+    if (header.magic != MAGIC || header.version != VERSION || toc_end > size) {
+        warn("Invalid asset pack (filename="s + filename + ")"s);
+        this->close();
+        return false;
+    }
+
+    auto const* toc = reinterpret_cast<TocEntry const*>(data.data() + sizeof(Header));
+    for (std::uint32_t i = 0; i < header.entry_count; ++i) {
+        auto const& entry = toc[i];
+        if (entry.name_offset + entry.name_size > size || entry.data_offset + entry.data_size > size) {
+            warn("Invalid asset pack entry (filename="s + filename + ", index="s + std::to_string(i) + ")"s);
+            this->close();
+            return false;
+        }
+        auto name = std::string(reinterpret_cast<char const*>(data.data() + entry.name_offset), entry.name_size);
+        this->entries[name] = Entry {
+            entry.type,
+            static_cast<int>(entry.width),
+            static_cast<int>(entry.height),
+            data.subspan(entry.data_offset, entry.data_size)
+        };
+    }
+    return true;
+}
+
+void AssetPack::close()
+{
+    this->file.close();
+    this->entries.clear();
+}
+
+std::optional<AssetPack::Entry> AssetPack::find(std::string const& filename) const
+{
+    auto it = this->entries.find(filename);
+    if (it == this->entries.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<AssetPack::Entry> AssetPack::find_image(std::string const& filename) const
+{
+    auto entry = this->find(filename);
+    if (!entry || entry->type != AssetType::rgba32_image) {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+std::vector<std::string> AssetPack::list(std::string const& directory, std::string const& extension) const
+{
+    auto filenames = std::vector<std::string>();
+    for (auto const& [name, _] : this->entries) {
+        if (name.starts_with(directory) && name.ends_with(extension)) {
+            filenames.push_back(name);
+        }
+    }
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+}
+
+AssetPack asset_pack;
@@ -0,0 +1,88 @@
+#ifndef PIGSGAME_ASSETPACK_HPP
+#define PIGSGAME_ASSETPACK_HPP
+
+#include <MappedFile.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Single file holding the game assets, baked by the AssetPacker tool. Images are stored already decoded as
+// SDL_PIXELFORMAT_RGBA32 pixels (tightly packed, pitch = 4 * width), so they can be uploaded as they are. Any
+// other file (maps, sounds) is stored verbatim. Assets are looked up by the same filename that would be used to
+// load the loose file (e.g. "assets/sprites/tiles.png").
+//
+// Layout: a Header, followed by header.entry_count TocEntries, the entry names and then the asset data. Offsets
+// are relative to the start of the file and the asset data is aligned to DATA_ALIGNMENT bytes.
+namespace asset_pack_format {
+    auto constexpr MAGIC = std::array<char, 8> { 'P', 'I', 'G', 'S', 'P', 'A', 'C', 'K' };
+    auto constexpr VERSION = std::uint32_t(1);
+    auto constexpr DATA_ALIGNMENT = std::uint64_t(16);
+
+    enum class AssetType : std::uint32_t {
+        raw = 0,
+        rgba32_image = 1,
+    };
+
+    struct Header {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t entry_count;
+    };
+    static_assert(sizeof(Header) == 16);
+
+    struct TocEntry {
+        std::uint64_t name_offset;
+        std::uint64_t data_offset;
+        std::uint64_t data_size;
+        std::uint32_t name_size;
+        AssetType type;
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+    static_assert(sizeof(TocEntry) == 40);
+}
+
+// Read-only view over a memory mapped asset pack. Entries point straight into the mapped file, so they are only
+// valid until the pack is closed.
+class AssetPack {
+public:
+    struct Entry {
+        asset_pack_format::AssetType type;
+        int width;
+        int height;
+        std::span<std::byte const> data;
+    };
+
+    AssetPack();
+    AssetPack(AssetPack const& other) = delete;
+    AssetPack& operator=(AssetPack const& other) = delete;
+    ~AssetPack();
+
+    // Returns false (and leaves the pack closed) if the file doesn't exist or isn't a valid asset pack
+    bool open(std::string const& filename);
+    void close();
+
+    [[nodiscard]] std::optional<Entry> find(std::string const& filename) const;
+    [[nodiscard]] std::optional<Entry> find_image(std::string const& filename) const;
+
+    // Names of all the entries inside `directory` (e.g. "assets/sprites/") with the given extension
+    [[nodiscard]] std::vector<std::string> list(std::string const& directory, std::string const& extension) const;
+
+    inline bool is_open() const
+    {
+        return this->file.is_open();
+    }
+
+private:
+    MappedFile file;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+extern AssetPack asset_pack;
+
+#endif //PIGSGAME_ASSETPACK_HPP
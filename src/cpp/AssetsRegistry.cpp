@@ -1,23 +1,76 @@
 #include <AssetsRegistry.hpp>
+#include <ReleaseQueue.hpp>
+#include <logging.hpp>
 
 void AssetsRegistry::load(SDL_Renderer* renderer)
 {
-    this->tileset = load_media("assets/sprites/tiles.png", renderer);
-    this->lifebar = load_media("assets/sprites/lifebar.png", renderer);
-    this->lifebar_heart = load_media("assets/sprites/small_heart18x14.png", renderer);
-    this->monogram = load_media("assets/sprites/monogram.png", renderer);
-    this->talk_baloon = load_media("assets/sprites/talk_baloon.png", renderer);
-    this->forest_background = load_media("assets/sprites/forest_background.png", renderer);
+    this->renderer = renderer;
+    this->render_thread = std::this_thread::get_id();
+    this->atlas.build(renderer, list_png_files("assets/sprites/"));
+
+    auto atlas_sprite = [this](std::string const& filename) {
+        auto spritesheet = this->atlas.find(filename);
+        if (!spritesheet) {
+            warn("Sprite sheet not found in the texture atlas: "s + filename);
+            return SpriteSheet();
+        }
+        return *spritesheet;
+    };
+    this->tileset = atlas_sprite("assets/sprites/tiles.png");
+    this->tileset_properties.load("assets/sprites/tiles.properties");
+    this->lifebar = atlas_sprite("assets/sprites/lifebar.png");
+    this->lifebar_heart = atlas_sprite("assets/sprites/small_heart18x14.png");
+    this->monogram = atlas_sprite("assets/sprites/monogram.png");
+    this->talk_baloon = atlas_sprite("assets/sprites/talk_baloon.png");
+    this->forest_background = atlas_sprite("assets/sprites/forest_background.png");
+    this->cannonball = atlas_sprite("assets/sprites/cannonball44x28.png");
+    this->boom = atlas_sprite("assets/sprites/boom80x80.png");
+    this->jump_smoke = atlas_sprite("assets/sprites/jump-smoke.png");
 }
 
-AssetsRegistry::~AssetsRegistry()
+void AssetsRegistry::unload()
 {
-    SDL_DestroyTexture(this->tileset);
-    SDL_DestroyTexture(this->lifebar);
-    SDL_DestroyTexture(this->lifebar_heart);
-    SDL_DestroyTexture(this->monogram);
-    SDL_DestroyTexture(this->talk_baloon);
-    SDL_DestroyTexture(this->forest_background);
+    for (auto const& [filename, texture] : this->textures) {
+        if (!texture.expired()) {
+            warn("Texture still referenced while unloading the assets: "s + filename);
+        }
+    }
+    this->textures.clear();
+    this->atlas.clear();
+    this->renderer = nullptr;
+}
+
+TextureRef AssetsRegistry::acquire(std::string const& filename)
+{
+    auto lock = std::lock_guard(this->textures_mutex);
+    auto& cached = this->textures[filename];
+    if (auto texture = cached.lock()) {
+        return texture;
+    }
+
+    auto texture = TextureRef();
+    if (auto spritesheet = this->atlas.find(filename)) {
+        // Atlas pages are owned by the atlas itself
+        texture = std::make_shared<SpriteSheet const>(*spritesheet);
+    } else {
+        if (std::this_thread::get_id() != this->render_thread) {
+            err("Images outside the texture atlas must be acquired from the render thread: "s + filename);
+        }
+        auto destroy = [](SpriteSheet const* spritesheet) {
+            SDL_DestroyTexture(spritesheet->texture);
+            delete spritesheet;
+        };
+        texture = TextureRef(new SpriteSheet(load_media(filename, this->renderer)), [this, destroy](SpriteSheet const* spritesheet) {
+            // The last reference may be dropped by the simulation thread, while a recorded frame still uses the texture
+            if (std::this_thread::get_id() != this->render_thread) {
+                release_queue.release(std::shared_ptr<SpriteSheet const>(spritesheet, destroy));
+                return;
+            }
+            destroy(spritesheet);
+        });
+    }
+    cached = texture;
+    return texture;
 }
 
 AssetsRegistry assets_registry;
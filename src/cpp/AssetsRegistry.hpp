@@ -3,18 +3,47 @@
 
 #include <SDL2/SDL.h>
 
+#include <TextureAtlas.hpp>
+#include <TileProperties.hpp>
 #include <sdl_wrappers.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Shared reference to a cached sprite sheet. The texture is released together with its last reference.
+using TextureRef = std::shared_ptr<SpriteSheet const>;
 
 struct AssetsRegistry {
     void load(SDL_Renderer* renderer);
-    ~AssetsRegistry();
-
-    SDL_Texture* tileset;
-    SDL_Texture* lifebar;
-    SDL_Texture* lifebar_heart;
-    SDL_Texture* monogram;
-    SDL_Texture* talk_baloon;
-    SDL_Texture* forest_background;
+
+    // Destroys the atlas and every cached texture. Must be called before the renderer is destroyed, after all
+    // TextureRefs are gone.
+    void unload();
+
+    // Path-keyed texture cache: images packed in the atlas are returned as-is, any other image is loaded once
+    // and shared while there are references to it. May be called while loading levels in the background, but
+    // images outside the atlas can only be loaded from the render thread (the one that called load).
+    TextureRef acquire(std::string const& filename);
+
+    SDL_Renderer* renderer;
+    std::thread::id render_thread;
+    std::mutex textures_mutex;
+    TextureAtlas atlas;
+    std::unordered_map<std::string, std::weak_ptr<SpriteSheet const>> textures;
+
+    SpriteSheet tileset;
+    TilesetProperties tileset_properties;
+    SpriteSheet lifebar;
+    SpriteSheet lifebar_heart;
+    SpriteSheet monogram;
+    SpriteSheet talk_baloon;
+    SpriteSheet forest_background;
+    // Sprites of the pooled objects, resolved once rather than on each spawn
+    SpriteSheet cannonball;
+    SpriteSheet boom;
+    SpriteSheet jump_smoke;
 };
 
 extern AssetsRegistry assets_registry;
@@ -0,0 +1,63 @@
+#include <FramePacer.hpp>
+#include <sdl_wrappers.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// How much the smoothed measures move towards each new sample
+auto constexpr SMOOTHING = 0.05;
+// Time (in milliseconds) spent spinning before a deadline, until SDL_Delay's oversleep has been measured
+auto constexpr INITIAL_SPIN_MARGIN = 2.0;
+}
+
+FramePacer::FramePacer(int target_frame_rate, bool vsync)
+    : target_frame_rate(0)
+    , vsync(vsync)
+    , frequency(SDL_GetPerformanceFrequency())
+    , frame_duration(0)
+    , deadline(0)
+    , last_frame_end(SDL_GetPerformanceCounter())
+    , spin_margin(INITIAL_SPIN_MARGIN)
+    , pacing_error(0.0)
+{
+    this->set_target_frame_rate(target_frame_rate);
+}
+
+void FramePacer::set_target_frame_rate(int frame_rate)
+{
+    this->target_frame_rate = std::max(1, frame_rate);
+    this->frame_duration = this->frequency / std::uint64_t(this->target_frame_rate);
+    this->deadline = SDL_GetPerformanceCounter() + this->frame_duration;
+}
+
+void FramePacer::wait()
+{
+    auto to_ms = [this](std::int64_t ticks) { return double(ticks) * 1000.0 / double(this->frequency); };
+
+    if (!this->vsync) {
+        auto remaining = to_ms(std::int64_t(this->deadline - SDL_GetPerformanceCounter()));
+        if (remaining > this->spin_margin) {
+            auto requested = Uint32(remaining - this->spin_margin);
+            auto before_sleep = SDL_GetPerformanceCounter();
+            SDL_Delay(requested);
+            auto oversleep = to_ms(std::int64_t(SDL_GetPerformanceCounter() - before_sleep)) - requested;
+            // Keep the margin a bit above the usual oversleep, so the sleep rarely overshoots the deadline
+            this->spin_margin += SMOOTHING * (std::clamp(2.0 * oversleep, 0.5, 8.0) - this->spin_margin);
+        }
+        while (std::int64_t(this->deadline - SDL_GetPerformanceCounter()) > 0) {
+        }
+    }
+
+    auto now = SDL_GetPerformanceCounter();
+    auto frame_error = std::abs(to_ms(std::int64_t(now - this->last_frame_end)) - to_ms(this->frame_duration));
+    auto pacing_error = this->pacing_error.load(std::memory_order_relaxed);
+    this->pacing_error.store(pacing_error + SMOOTHING * (frame_error - pacing_error), std::memory_order_relaxed);
+    this->last_frame_end = now;
+
+    // Deadlines follow each other exactly, unless the frame was late by more than a whole frame; then there's no point
+    // in rushing the next frames to catch up
+    this->deadline += this->frame_duration;
+    if (std::int64_t(now - this->deadline) > 0) {
+        this->deadline = now + this->frame_duration;
+    }
+}
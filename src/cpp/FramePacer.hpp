@@ -0,0 +1,47 @@
+#ifndef PIGSGAME_FRAMEPACER_HPP
+#define PIGSGAME_FRAMEPACER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// Keeps frames at a steady rate. With vsync, presenting already blocks until the display refresh, so the pacer only
+// measures. Otherwise it sleeps until shortly before the frame deadline and spins on the performance counter for the
+// rest, since SDL_Delay alone is only accurate to a millisecond (often worse).
+class FramePacer {
+public:
+    FramePacer(int target_frame_rate, bool vsync);
+
+    void set_target_frame_rate(int frame_rate);
+
+    // Waits for the end of the current frame
+    void wait();
+
+    inline int get_target_frame_rate() const
+    {
+        return this->target_frame_rate;
+    }
+
+    inline bool is_vsync_enabled() const
+    {
+        return this->vsync;
+    }
+
+    // Average distance (in milliseconds) between the measured frame durations and the target one. May be read from
+    // any thread.
+    inline double get_pacing_error() const
+    {
+        return this->pacing_error.load(std::memory_order_relaxed);
+    }
+
+private:
+    int target_frame_rate;
+    bool vsync;
+    std::uint64_t frequency;
+    std::uint64_t frame_duration;
+    std::uint64_t deadline;
+    std::uint64_t last_frame_end;
+    double spin_margin;
+    std::atomic<double> pacing_error;
+};
+
+#endif //PIGSGAME_FRAMEPACER_HPP
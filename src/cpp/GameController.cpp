@@ -23,12 +23,11 @@ GameController::~GameController()
 {
 }
 
-void GameController::update()
+void GameController::update(Uint8 const* keyboard_state)
 {
-    auto keystate = SDL_GetKeyboardState(nullptr);
     for (auto const& [k, _] : this->keyconfig) {
         auto const& sdl_key = this->keyconfig[k];
-        if (keystate[sdl_key]) {
+        if (keyboard_state[sdl_key]) {
             if (this->keystate[k] == ControllerState::NotPressed) {
                 this->keystate[k] = ControllerState::JustPressed;
             } else {
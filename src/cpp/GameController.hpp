@@ -28,7 +28,8 @@ public:
     GameController();
     ~GameController();
 
-    void update();
+    // Updates the actions' states from SDL's keyboard state (indexed by scancode)
+    void update(Uint8 const* keyboard_state);
     ControllerState get_state(ControllerAction const& action) const;
     bool just_pressed(ControllerAction const& action) const;
     bool is_pressed(ControllerAction const& action) const;
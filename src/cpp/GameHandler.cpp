@@ -1,7 +1,10 @@
+#include <AssetPack.hpp>
 #include <AssetsRegistry.hpp>
 #include <SoundHandler.hpp>
 #include <GameController.hpp>
 #include <GameHandler.hpp>
+#include <JobSystem.hpp>
+#include <ReleaseQueue.hpp>
 #include <collision/character_collision.hpp>
 #include <levels/EntryLevel.hpp>
 #include <screens/GameScreen.hpp>
@@ -25,7 +28,8 @@ namespace {
 
     SDL_Renderer* create_renderer(SDL_Window* window)
     {
-        auto* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+        auto vsync_flag = ENABLE_VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+        auto* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | vsync_flag);
         if (renderer == nullptr) {
             renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
         }
@@ -34,16 +38,61 @@ namespace {
         }
         return renderer;
     }
+
+    bool has_vsync(SDL_Renderer* renderer)
+    {
+        auto renderer_info = SDL_RendererInfo {};
+        if (renderer == nullptr || SDL_GetRendererInfo(renderer, &renderer_info) != 0) {
+            return false;
+        }
+        return (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+    }
+
+    int display_refresh_rate(SDL_Window* window)
+    {
+        auto display_mode = SDL_DisplayMode {};
+        if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &display_mode) != 0 || display_mode.refresh_rate <= 0) {
+            warn("Could not get the display refresh rate, assuming 60 Hz");
+            return 60;
+        }
+        return display_mode.refresh_rate;
+    }
+
+    // With vsync the frames come at the display refresh rate, whatever the target is
+    FramePacer create_frame_pacer(SDL_Window* window, SDL_Renderer* renderer)
+    {
+        auto vsync = has_vsync(renderer);
+        if (ENABLE_VSYNC && !vsync) {
+            warn("Vsync is not available, pacing frames with timers");
+        }
+        auto frame_rate = (vsync || TARGET_FRAME_RATE <= 0) ? display_refresh_rate(window) : TARGET_FRAME_RATE;
+        return FramePacer(frame_rate, vsync);
+    }
+
+    // The main and the simulation threads already take two cores; the simulation thread works on its loops too
+    std::size_t job_system_workers()
+    {
+        auto const cores = std::size_t(std::thread::hardware_concurrency());
+        return cores > 2 ? cores - 2 : 0;
+    }
 }
 
 std::unique_ptr<TitleScreen> GameHandler::create_title_screen(GameHandler* game_handler)
 {
     auto on_new_game = [game_handler](){
-        game_handler->transition_animation.register_transition_callback([game_handler]() {
-            auto game_screen = std::make_unique<GameScreen>(*game_handler);
-            game_screen->set_active_level(std::make_unique<EntryLevel>(*game_handler));
-            game_handler->screen = std::move(game_screen);
-        });
+        game_handler->transition_animation.register_transition_loader<IGameLevel>(
+            [game_handler]() -> std::unique_ptr<IGameLevel> {
+                return std::make_unique<EntryLevel>(*game_handler);
+            },
+            [game_handler](std::unique_ptr<IGameLevel>&& level) {
+                // Levels are built on a loader thread, the music only changes once the level is swapped in
+                sound_handler.play_music("forest");
+                auto game_screen = std::make_unique<GameScreen>(*game_handler);
+                game_screen->set_active_level(std::move(level));
+                release_queue.release(std::move(game_handler->screen));
+                game_handler->screen = std::move(game_screen);
+            }
+        );
         game_handler->transition_animation.reset();
     };
     auto on_game_exit = [game_handler](){
@@ -55,19 +104,49 @@ std::unique_ptr<TitleScreen> GameHandler::create_title_screen(GameHandler* game_
 GameHandler::GameHandler()
     : window(create_window())
     , renderer(create_renderer(this->window))
-    , screen(GameHandler::create_title_screen(this))
+    , frame_pacer(create_frame_pacer(this->window, this->renderer))
     , game_finished(false)
+    , render_targets_reset(false)
+    , time_handler()
+    , screen(GameHandler::create_title_screen(this))
+    , window_shaker()
+    , transition_animation()
+    , input()
+    , simulated_frames(0)
+    , input_mutex()
+    , pending_input()
+    , requested_frames(0)
+    , snapshots()
+    , simulation_thread()
 {
     SDL_SetRenderDrawBlendMode(this->renderer, SDL_BLENDMODE_BLEND);
+    if (!asset_pack.open("assets.pack")) {
+        info("No asset pack found, loading loose asset files");
+    }
     assets_registry.load(this->renderer);
     sound_handler.load();
 
     // TODO: Move this to the TitleScreen class
     sound_handler.play_music("title_screen");
+
+    job_system.start(job_system_workers());
+    info("Running the simulation loops on "s + std::to_string(job_system.thread_count()) + " threads");
+    this->simulation_thread = std::thread([this]() { this->run_simulation(); });
 }
 
 GameHandler::~GameHandler()
 {
+    this->game_finished = true;
+    this->request_simulation_frame();
+    this->simulation_thread.join();
+    job_system.stop();
+
+    // Everything holding textures must be gone before the assets (and then the renderer) are destroyed
+    release_queue.clear();
+    this->screen.reset();
+    assets_registry.unload();
+    sound_handler.unload();
+    asset_pack.close();
     SDL_DestroyRenderer(this->renderer);
     SDL_DestroyWindow(this->window);
 }
@@ -79,35 +158,99 @@ void GameHandler::process_inputs()
         if (e.type == SDL_QUIT) {
             this->game_finished = true;
         }
+        if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+            this->render_targets_reset = true;
+        }
     }
 
-    game_controller.update();
-    this->screen->handle_controller(game_controller);
+    auto n_keys = 0;
+    auto const* keyboard_state = SDL_GetKeyboardState(&n_keys);
+    auto mouse_position = Vector2D<int> { 0, 0 };
+    SDL_GetMouseState(&mouse_position.x, &mouse_position.y);
+
+    auto lock = std::lock_guard(this->input_mutex);
+    this->pending_input.keyboard_state.assign(keyboard_state, keyboard_state + n_keys);
+    this->pending_input.mouse_position = mouse_position;
 }
 
 void GameHandler::update()
 {
-    this->time_handler.update();
-    this->screen->update(this->time_handler.get_elapsed_time());
+    this->request_simulation_frame();
 }
 
 void GameHandler::render()
 {
-    auto elapsed_time = this->time_handler.get_elapsed_time();
+    auto const& snapshot = this->snapshots.acquire();
+    // The tilemap caches are only reachable through the draw lists here, as the screens belong to the simulation thread
+    if (this->render_targets_reset) {
+        snapshot.draw_list.invalidate_tilemaps();
+        this->render_targets_reset = false;
+    }
 
     SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 255);
     SDL_RenderClear(this->renderer);
-    this->screen->render(this->renderer, elapsed_time);
-    if (this->transition_animation.current_state() != TransitionAnimationState::finished) {
-        this->transition_animation.run(this->renderer, elapsed_time);
-    }
+    snapshot.draw_list.submit(this->renderer);
     SDL_RenderPresent(this->renderer);
+
+    release_queue.collect(snapshot.frame);
 }
 
 void GameHandler::delay()
 {
+    this->frame_pacer.wait();
+}
+
+void GameHandler::request_simulation_frame()
+{
+    this->requested_frames.fetch_add(1);
+    this->requested_frames.notify_one();
+}
+
+void GameHandler::run_simulation()
+{
+    auto handled_requests = std::uint64_t(0);
+    while (true) {
+        // Requests made while simulating a frame are merged into the next one
+        this->requested_frames.wait(handled_requests);
+        handled_requests = this->requested_frames.load();
+        if (this->game_finished) {
+            return;
+        }
+        this->simulate_frame();
+    }
+}
+
+void GameHandler::simulate_frame()
+{
+    {
+        auto lock = std::lock_guard(this->input_mutex);
+        this->input.keyboard_state = this->pending_input.keyboard_state;
+        this->input.mouse_position = this->pending_input.mouse_position;
+    }
+    // Nothing to simulate before the first inputs
+    if (this->input.keyboard_state.empty()) {
+        return;
+    }
+
+    auto frame = ++this->simulated_frames;
+    release_queue.begin_frame(frame);
+
+    game_controller.update(this->input.keyboard_state.data());
+    this->screen->handle_controller(game_controller);
+
+    this->time_handler.update();
+    while (this->time_handler.next_tick()) {
+        this->screen->update(TICK_DURATION);
+    }
+
     auto elapsed_time = this->time_handler.get_elapsed_time();
-    if (elapsed_time < 1. / 70.) {
-        SDL_Delay(1000 * (1 / 70. - elapsed_time));
+    auto& snapshot = this->snapshots.back();
+    snapshot.frame = frame;
+    snapshot.draw_list.reset();
+    this->screen->render(snapshot.draw_list, elapsed_time);
+    snapshot.draw_list.flush();
+    if (this->transition_animation.current_state() != TransitionAnimationState::finished) {
+        this->transition_animation.run(snapshot.draw_list, elapsed_time);
     }
+    this->snapshots.publish();
 }
@@ -2,24 +2,38 @@
 #define __GAME_HANDLER_HPP
 
 #include <StateTimeout.hpp>
+#include <FramePacer.hpp>
 #include <GameTimeHandler.hpp>
+#include <TripleBuffer.hpp>
 #include <Vector2D.hpp>
+#include <drawing.hpp>
 #include <levels/IGameLevel.hpp>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <random.hpp>
 #include <sdl_wrappers.hpp>
 #include <screens/TitleScreen.hpp>
+#include <thread>
 #include <TransitionAnimation.hpp>
+#include <vector>
 #include <WindowShaker.hpp>
 
 class SDL_Window;
 
+// The game runs on two threads. The simulation thread updates the active screen and records its drawing into a
+// frame snapshot (an immutable DrawList), while the main thread handles the SDL events and draws the last recorded
+// snapshot: the simulation of frame N + 1 overlaps with the rendering of frame N. Snapshots go from one thread to the
+// other through a triple buffer, and the inputs through a (briefly) locked copy.
 class GameHandler {
 public:
     GameHandler();
     ~GameHandler();
 
+    // Main thread
     void process_inputs();
+    // Requests the next frame from the simulation thread
     void update();
     void render();
     void delay();
@@ -29,9 +43,11 @@ public:
         return this->game_finished;
     }
 
-    inline SDL_Renderer* get_renderer()
+    // The accessors below are meant for the simulation thread
+
+    inline Vector2D<int> const& get_mouse_position() const
     {
-        return this->renderer;
+        return this->input.mouse_position;
     }
 
     // TODO: const correctness
@@ -56,17 +72,49 @@ public:
     {
         return this->time_handler;
     }
+
+    inline FramePacer const& get_frame_pacer() const
+    {
+        return this->frame_pacer;
+    }
 private:
+    struct InputState {
+        std::vector<Uint8> keyboard_state;
+        Vector2D<int> mouse_position;
+    };
+
+    struct FrameSnapshot {
+        // Frames are numbered from 1 on, a snapshot of frame 0 is empty
+        std::uint64_t frame = 0;
+        DrawList draw_list;
+    };
+
     static std::unique_ptr<TitleScreen> create_title_screen(GameHandler* game_handler);
+    void request_simulation_frame();
+    void run_simulation();
+    void simulate_frame();
 
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
+    FramePacer frame_pacer;
+    std::atomic<bool> game_finished;
+    // Main thread: set when the renderer lost its render targets, until the tilemap caches are invalidated
+    bool render_targets_reset;
+
+    // Simulation thread
     GameTimeHandler time_handler;
-    bool game_finished;
     std::unique_ptr<IScreen> screen;
     WindowShaker window_shaker;
     TransitionAnimation transition_animation;
+    InputState input;
+    std::uint64_t simulated_frames;
+
+    std::mutex input_mutex;
+    InputState pending_input;
+    std::atomic<std::uint64_t> requested_frames;
+    TripleBuffer<FrameSnapshot> snapshots;
+    std::thread simulation_thread;
 };
 
 #endif
@@ -1,9 +1,151 @@
 #include <GameMap.hpp>
 
+Tilemap::Tilemap(int width, int height)
+    : width(width)
+    , height(height)
+    , chunk_loader()
+    , first_column(0)
+    , n_columns(width)
+    , tiles(std::size_t(width) * height, 0)
+    , paged_tiles()
+    , chunk_tiles()
+{
+}
+
+Tilemap::Tilemap(int width, int height, ChunkLoader const& chunk_loader)
+    : width(width)
+    , height(height)
+    , chunk_loader(chunk_loader)
+    , first_column(0)
+    , n_columns(0)
+    , tiles()
+    , paged_tiles()
+    , chunk_tiles()
+{
+}
+
+void Tilemap::set(int i, int j, TileId tile_id)
+{
+    auto column = j - this->first_column;
+    if (column >= 0 && column < this->n_columns) {
+        this->tiles[std::size_t(i) * this->n_columns + column] = tile_id;
+    }
+}
+
+void Tilemap::set_row(int i, std::span<TileId const> tiles)
+{
+    auto resident = tiles.subspan(this->first_column, this->n_columns);
+    std::copy(resident.begin(), resident.end(), this->row(i).begin());
+}
+
+void Tilemap::set_chunk(int chunk, std::span<TileId const> tiles)
+{
+    auto chunk_width = this->chunk_width(chunk);
+    for (int i = 0; i < this->height; ++i) {
+        for (int column = 0; column < chunk_width; ++column) {
+            this->set(i, chunk * CHUNK_COLUMNS + column, tiles[std::size_t(i) * chunk_width + column]);
+        }
+    }
+}
+
+void Tilemap::fill(TileId tile_id)
+{
+    std::fill(this->tiles.begin(), this->tiles.end(), tile_id);
+}
+
+void Tilemap::page_in(int first_column, int last_column)
+{
+    if (!this->chunk_loader || this->width <= 0) {
+        return;
+    }
+    auto const n_chunks = this->chunk_count();
+    auto const first_chunk = std::clamp(first_column / CHUNK_COLUMNS, 0, std::max(n_chunks - 1, 0));
+    auto const last_chunk = std::clamp(last_column / CHUNK_COLUMNS, first_chunk, std::max(n_chunks - 1, 0));
+    auto const first_resident_chunk = this->first_column / CHUNK_COLUMNS;
+    if (this->n_columns > 0 && first_chunk >= first_resident_chunk
+        && last_chunk < first_resident_chunk + this->resident_chunk_count()) {
+        return;
+    }
+
+    // The new window is centered on the requested columns, so that it doesn't move again for a while
+    auto const window_chunks = std::min(MAX_RESIDENT_CHUNKS, n_chunks);
+    auto const requested_chunks = last_chunk - first_chunk + 1;
+    auto const new_first_chunk = std::clamp(first_chunk - std::max(0, window_chunks - requested_chunks) / 2, 0,
+        n_chunks - window_chunks);
+    auto const new_first_column = new_first_chunk * CHUNK_COLUMNS;
+    auto const new_n_columns = std::min(this->width, (new_first_chunk + window_chunks) * CHUNK_COLUMNS) - new_first_column;
+
+    // Chunks in both windows are kept, the others are loaded
+    this->paged_tiles.resize(std::size_t(new_n_columns) * this->height);
+    auto const kept_begin = std::max(this->first_column, new_first_column);
+    auto const kept_end = std::min(this->first_column + this->n_columns, new_first_column + new_n_columns);
+    for (int i = 0; kept_begin < kept_end && i < this->height; ++i) {
+        auto const* from = this->tiles.data() + std::size_t(i) * this->n_columns + (kept_begin - this->first_column);
+        std::copy(from, from + (kept_end - kept_begin),
+            this->paged_tiles.data() + std::size_t(i) * new_n_columns + (kept_begin - new_first_column));
+    }
+    std::swap(this->tiles, this->paged_tiles);
+    this->first_column = new_first_column;
+    this->n_columns = new_n_columns;
+    for (int chunk = new_first_chunk; chunk < new_first_chunk + window_chunks; ++chunk) {
+        auto const chunk_first_column = chunk * CHUNK_COLUMNS;
+        if (kept_begin < kept_end && chunk_first_column >= kept_begin && chunk_first_column < kept_end) {
+            continue;
+        }
+        this->load_chunk(chunk);
+    }
+}
+
+void Tilemap::read_chunk(int chunk, std::span<TileId> tiles) const
+{
+    if (this->chunk_loader) {
+        this->chunk_loader(chunk, tiles);
+        return;
+    }
+    auto chunk_width = this->chunk_width(chunk);
+    for (int i = 0; i < this->height; ++i) {
+        auto row = this->row(i).subspan(std::size_t(chunk) * CHUNK_COLUMNS, chunk_width);
+        std::copy(row.begin(), row.end(), tiles.begin() + std::size_t(i) * chunk_width);
+    }
+}
+
+void Tilemap::load_chunk(int chunk)
+{
+    auto chunk_width = this->chunk_width(chunk);
+    this->chunk_tiles.resize(std::size_t(chunk_width) * this->height);
+    this->chunk_loader(chunk, this->chunk_tiles);
+    this->set_chunk(chunk, this->chunk_tiles);
+}
+
+TilemapReader::TilemapReader(Tilemap const& tilemap)
+    : tilemap(tilemap)
+    , cached_chunks { CachedChunk { -1, {} }, CachedChunk { -1, {} } }
+    , next_evicted(0)
+{
+}
+
+TileId TilemapReader::operator()(int i, int j)
+{
+    auto chunk = j / Tilemap::CHUNK_COLUMNS;
+    auto chunk_width = this->tilemap.chunk_width(chunk);
+    for (auto const& cached : this->cached_chunks) {
+        if (cached.chunk == chunk) {
+            return cached.tiles[std::size_t(i) * chunk_width + j % Tilemap::CHUNK_COLUMNS];
+        }
+    }
+    auto& cached = this->cached_chunks[this->next_evicted];
+    this->next_evicted = (this->next_evicted + 1) % this->cached_chunks.size();
+    cached.chunk = chunk;
+    cached.tiles.resize(std::size_t(chunk_width) * this->tilemap.row_count());
+    this->tilemap.read_chunk(chunk, cached.tiles);
+    return cached.tiles[std::size_t(i) * chunk_width + j % Tilemap::CHUNK_COLUMNS];
+}
+
 GameMap::GameMap(int width, int height)
     : width(width)
     , height(height)
-    , tilemap { std::vector<std::vector<int>>(height, std::vector<int>(width)) }
+    , tilemap(width, height)
+    , triggers(width, height)
     , interactables { 0 }
 {
 }
@@ -2,10 +2,141 @@
 #define __GAMEMAP_HPP
 
 #include <Vector2D.hpp>
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
 #include <vector>
 
-using Tilemap = std::vector<std::vector<int>>;
+using TileId = std::uint16_t;
+
+// Tile ids of a map in one contiguous buffer, row by row. Row 0 is the top row of the map.
+//
+// Tilemaps created with a ChunkLoader (see stream_map) only keep a window of at most MAX_RESIDENT_CHUNKS chunks of
+// CHUNK_COLUMNS columns in memory, so their memory usage doesn't depend on the map width. The window is moved
+// explicitly, with page_in(); reads never page, so any number of threads can read a tilemap that isn't being paged
+// or changed. Tiles out of the window read as 0. Other tilemaps are always fully resident.
+class Tilemap {
+public:
+    static auto constexpr CHUNK_COLUMNS = 32;
+    static auto constexpr MAX_RESIDENT_CHUNKS = 64;
+
+    // Fills `tiles` with the tiles of the given chunk, row by row
+    using ChunkLoader = std::function<void(int chunk, std::span<TileId> tiles)>;
+
+    Tilemap(int width, int height);
+    Tilemap(int width, int height, ChunkLoader const& chunk_loader);
+
+    inline TileId operator()(int i, int j) const
+    {
+        auto column = j - this->first_column;
+        if (column < 0 || column >= this->n_columns) {
+            return 0;
+        }
+        return this->tiles[std::size_t(i) * this->n_columns + column];
+    }
+
+    // Resident columns of a row
+    inline std::span<TileId> row(int i)
+    {
+        return { this->tiles.data() + std::size_t(i) * this->n_columns, std::size_t(this->n_columns) };
+    }
+
+    inline std::span<TileId const> row(int i) const
+    {
+        return { this->tiles.data() + std::size_t(i) * this->n_columns, std::size_t(this->n_columns) };
+    }
+
+    // All the resident tiles, row by row
+    inline std::span<TileId> data()
+    {
+        return this->tiles;
+    }
+
+    inline std::span<TileId const> data() const
+    {
+        return this->tiles;
+    }
+
+    // Changes are meant for fully resident tilemaps: in a streamed tilemap, they'd be lost with their chunk
+    void set(int i, int j, TileId tile_id);
+    void set_row(int i, std::span<TileId const> tiles);
+    void set_chunk(int chunk, std::span<TileId const> tiles);
+    void fill(TileId tile_id);
+
+    // Moves the window of a streamed tilemap so that it covers the given columns (as many of them as fit), loading
+    // the chunks it didn't cover yet. Does nothing on fully resident tilemaps.
+    void page_in(int first_column, int last_column);
+
+    // Fills `tiles` with the tiles of a chunk, row by row, whether it's resident or not, without paging. Only reads
+    // the map file on streamed tilemaps, so it's safe while the tilemap is being paged, e.g. for whole map passes.
+    void read_chunk(int chunk, std::span<TileId> tiles) const;
+
+    inline int row_count() const
+    {
+        return this->height;
+    }
+
+    inline int chunk_count() const
+    {
+        return (this->width + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS;
+    }
+
+    inline int chunk_width(int chunk) const
+    {
+        return std::min(CHUNK_COLUMNS, this->width - chunk * CHUNK_COLUMNS);
+    }
+
+    inline int first_resident_column() const
+    {
+        return this->first_column;
+    }
+
+    inline int resident_column_count() const
+    {
+        return this->n_columns;
+    }
+
+    inline int resident_chunk_count() const
+    {
+        return (this->n_columns + CHUNK_COLUMNS - 1) / CHUNK_COLUMNS;
+    }
+
+private:
+    void load_chunk(int chunk);
+
+private:
+    int width;
+    int height;
+    ChunkLoader chunk_loader;
+    // Resident columns: the whole map, unless streamed
+    int first_column;
+    int n_columns;
+    std::vector<TileId> tiles;
+    // Reused by page_in, so that moving the window doesn't allocate once it's been moved once
+    std::vector<TileId> paged_tiles;
+    std::vector<TileId> chunk_tiles;
+};
+
+// Reads a tilemap tile by tile through Tilemap::read_chunk, keeping the last two chunks read, for whole map passes
+// that go through the map column by column (see merge_tiles).
+class TilemapReader {
+public:
+    explicit TilemapReader(Tilemap const& tilemap);
+
+    TileId operator()(int i, int j);
+
+private:
+    struct CachedChunk {
+        int chunk;
+        std::vector<TileId> tiles;
+    };
+
+    Tilemap const& tilemap;
+    std::array<CachedChunk, 2> cached_chunks;
+    std::size_t next_evicted;
+};
 
 struct InteractableInfo {
     Vector2D<int> position;
@@ -17,6 +148,8 @@ struct GameMap {
     int width;
     int height;
     Tilemap tilemap;
+    // Callback ids of the trigger zones painted over the map (0 for none), laid out as the tilemap. See TriggerZones.
+    Tilemap triggers;
     std::vector<InteractableInfo> interactables;
 
     GameMap(int width, int height);
@@ -1,5 +1,6 @@
 #include <GameTimeHandler.hpp>
 #include <sdl_wrappers.hpp>
+#include <algorithm>
 
 GameTimeHandler::GameTimeHandler()
         : last(0ull)
@@ -7,6 +8,8 @@ GameTimeHandler::GameTimeHandler()
         , fps_countdown(1000.)
         , fps_counter(0)
         , fps(0)
+        , elapsed_time(0.)
+        , accumulator(0.)
 {}
 
 void GameTimeHandler::update()
@@ -21,4 +24,15 @@ void GameTimeHandler::update()
         this->fps_counter = 0;
         this->fps_countdown = 1000.;
     }
+
+    this->accumulator = std::min(this->accumulator + this->elapsed_time, MAX_TICKS_PER_FRAME * TICK_DURATION);
+}
+
+bool GameTimeHandler::next_tick()
+{
+    if (this->accumulator < TICK_DURATION) {
+        return false;
+    }
+    this->accumulator -= TICK_DURATION;
+    return true;
 }
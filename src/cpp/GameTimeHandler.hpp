@@ -1,6 +1,8 @@
 #ifndef PIGSGAME_GAMETIMEHANDLER_HPP
 #define PIGSGAME_GAMETIMEHANDLER_HPP
 
+#include <constants.hpp>
+
 class GameTimeHandler
 {
 public:
@@ -8,6 +10,9 @@ public:
 
     void update();
 
+    // Consumes one simulation tick from the accumulated frame time, if a whole tick is available
+    bool next_tick();
+
     inline unsigned long long get_fps() const
     {
         return this->fps;
@@ -18,6 +23,12 @@ public:
         return this->elapsed_time;
     }
 
+    // How far (from 0 to 1) rendering is between the last simulation tick and the next one
+    inline double get_interpolation() const
+    {
+        return this->accumulator / TICK_DURATION;
+    }
+
 private:
     unsigned long long last;
     unsigned long long current;
@@ -25,6 +36,7 @@ private:
     unsigned long long fps;
     double fps_countdown;
     double elapsed_time;
+    double accumulator;
 };
 
 #endif //PIGSGAME_GAMETIMEHANDLER_HPP
@@ -0,0 +1,144 @@
+#include <JobSystem.hpp>
+#include <algorithm>
+#include <optional>
+
+namespace {
+thread_local int current_thread_index = -1;
+} // namespace
+
+JobSystem::JobSystem()
+    : queues()
+    , workers()
+    , wake_mutex()
+    , wake()
+    , stopping(false)
+    , queued_chunks(0)
+    , pending_chunks(0)
+{
+    this->queues.push_back(std::make_unique<Queue>());
+}
+
+JobSystem::~JobSystem()
+{
+    this->stop();
+}
+
+void JobSystem::start(std::size_t n_workers)
+{
+    this->stop();
+    for (std::size_t i = 0; i < n_workers; ++i) {
+        this->queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 1; i <= n_workers; ++i) {
+        this->workers.emplace_back([this, i]() { this->work(i); });
+    }
+}
+
+void JobSystem::stop()
+{
+    {
+        auto lock = std::lock_guard(this->wake_mutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    for (auto& worker : this->workers) {
+        worker.join();
+    }
+    this->workers.clear();
+    this->queues.resize(1);
+    this->stopping = false;
+}
+
+int JobSystem::current_thread()
+{
+    return current_thread_index;
+}
+
+void JobSystem::run_loop(std::size_t count, std::size_t grain, ChunkFunction function, void const* context)
+{
+    grain = std::max(grain, std::size_t(1));
+    auto const n_chunks = (count + grain - 1) / grain;
+    auto const run_serially = [&]() {
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            function(context, begin, std::min(begin + grain, count));
+        }
+    };
+
+    if (current_thread_index >= 0) {
+        run_serially();
+        return;
+    }
+    current_thread_index = 0;
+    if (n_chunks <= 1 || this->workers.empty()) {
+        run_serially();
+        current_thread_index = -1;
+        return;
+    }
+
+    this->pending_chunks = n_chunks;
+    this->queued_chunks += n_chunks;
+    auto const n_threads = this->queues.size();
+    for (std::size_t i = 0; i < n_chunks; ++i) {
+        auto& queue = *this->queues[i * n_threads / n_chunks];
+        auto const begin = i * grain;
+        auto lock = std::lock_guard(queue.mutex);
+        queue.chunks.push_back(Chunk { function, context, begin, std::min(begin + grain, count) });
+    }
+    {
+        // The workers look at queued_chunks under the lock before going to sleep
+        auto lock = std::lock_guard(this->wake_mutex);
+    }
+    this->wake.notify_all();
+
+    while (this->pending_chunks > 0) {
+        if (!this->run_one(0)) {
+            std::this_thread::yield();
+        }
+    }
+    current_thread_index = -1;
+}
+
+bool JobSystem::run_one(std::size_t thread)
+{
+    auto chunk = std::optional<Chunk>();
+    auto const n_threads = this->queues.size();
+    for (std::size_t i = 0; i < n_threads && !chunk; ++i) {
+        auto& queue = *this->queues[(thread + i) % n_threads];
+        auto lock = std::lock_guard(queue.mutex);
+        if (queue.chunks.empty()) {
+            continue;
+        }
+        // Own chunks are taken in order, stolen ones from the other end
+        if (i == 0) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+        } else {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+        }
+    }
+    if (!chunk) {
+        return false;
+    }
+    this->queued_chunks--;
+    chunk->function(chunk->context, chunk->begin, chunk->end);
+    this->pending_chunks--;
+    return true;
+}
+
+void JobSystem::work(std::size_t thread)
+{
+    current_thread_index = int(thread);
+    while (true) {
+        if (this->run_one(thread)) {
+            continue;
+        }
+        auto lock = std::unique_lock(this->wake_mutex);
+        this->wake.wait(lock, [this]() { return this->stopping || this->queued_chunks > 0; });
+        if (this->stopping) {
+            return;
+        }
+    }
+}
+
+JobSystem job_system;
@@ -0,0 +1,78 @@
+#ifndef PIGSGAME_JOBSYSTEM_HPP
+#define PIGSGAME_JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads running the parallel loops of the simulation thread. A loop is split in chunks, dealt in contiguous
+// blocks to the threads' queues; each thread runs the chunks of its own queue first, then steals from the back of the
+// other ones, so the loop is balanced even when some chunks take longer. The thread starting the loop works on it
+// too, and returns once every chunk ran.
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+
+    // Starts `n_workers` threads besides the one running the loops. Without workers, the loops run on that thread.
+    void start(std::size_t n_workers);
+    void stop();
+
+    // Threads working on a loop, the one that started it included
+    inline std::size_t thread_count() const
+    {
+        return this->queues.size();
+    }
+
+    // Index in [0, thread_count()) of the current thread while it runs a chunk of a loop, -1 outside of the loops
+    static int current_thread();
+
+    // Calls f(begin, end) on chunks of up to `grain` indices covering [0, count). A loop started from a chunk runs
+    // right away on the current thread.
+    template <typename F>
+    void parallel_for(std::size_t count, std::size_t grain, F const& f)
+    {
+        auto run_chunk = [](void const* context, std::size_t begin, std::size_t end) {
+            (*static_cast<F const*>(context))(begin, end);
+        };
+        this->run_loop(count, grain, run_chunk, &f);
+    }
+
+private:
+    using ChunkFunction = void (*)(void const* context, std::size_t begin, std::size_t end);
+
+    struct Chunk {
+        ChunkFunction function;
+        void const* context;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void run_loop(std::size_t count, std::size_t grain, ChunkFunction function, void const* context);
+    // Runs a chunk of the thread's queue, or else one stolen from another queue. Returns false if there was none.
+    bool run_one(std::size_t thread);
+    void work(std::size_t thread);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    bool stopping;
+    // Chunks not picked by any thread yet, and chunks of the current loop not done yet
+    std::atomic<std::size_t> queued_chunks;
+    std::atomic<std::size_t> pending_chunks;
+};
+
+extern JobSystem job_system;
+
+#endif //PIGSGAME_JOBSYSTEM_HPP
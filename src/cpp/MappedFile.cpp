@@ -0,0 +1,55 @@
+#include <MappedFile.hpp>
+#include <logging.hpp>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile()
+    : mapped_data(nullptr)
+    , mapped_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    this->close();
+}
+
+bool MappedFile::open(std::string const& filename)
+{
+    this->close();
+
+    auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0 || file_status.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    auto size = static_cast<std::size_t>(file_status.st_size);
+    auto* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file descriptor is closed
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        warn("Unable to map file (filename="s + filename + "): "s + std::strerror(errno));
+        return false;
+    }
+    this->mapped_data = static_cast<std::byte const*>(mapping);
+    this->mapped_size = size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (this->mapped_data != nullptr) {
+        munmap(const_cast<std::byte*>(this->mapped_data), this->mapped_size);
+    }
+    this->mapped_data = nullptr;
+    this->mapped_size = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef PIGSGAME_MAPPEDFILE_HPP
+#define PIGSGAME_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are only read from disk when touched, and may be dropped again
+// by the OS under memory pressure.
+class MappedFile {
+public:
+    MappedFile();
+    MappedFile(MappedFile const& other) = delete;
+    MappedFile& operator=(MappedFile const& other) = delete;
+    ~MappedFile();
+
+    // Returns false (and leaves the file closed) if the file can't be opened or mapped
+    bool open(std::string const& filename);
+    void close();
+
+    inline std::span<std::byte const> data() const
+    {
+        return { this->mapped_data, this->mapped_size };
+    }
+
+    inline bool is_open() const
+    {
+        return this->mapped_data != nullptr;
+    }
+
+private:
+    std::byte const* mapped_data;
+    std::size_t mapped_size;
+};
+
+#endif //PIGSGAME_MAPPEDFILE_HPP
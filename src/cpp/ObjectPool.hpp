@@ -0,0 +1,139 @@
+#ifndef PIGSGAME_OBJECTPOOL_HPP
+#define PIGSGAME_OBJECTPOOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+
+// Handle to an object of an ObjectPool. It goes stale once the object is despawned, even if its slot is reused.
+struct PoolHandle {
+    static auto constexpr NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index = NO_INDEX;
+    std::uint32_t generation = 0;
+
+    inline bool is_valid() const
+    {
+        return this->index != NO_INDEX;
+    }
+};
+
+// Fixed capacity storage for short lived objects (projectiles, one-shot effects): spawning and despawning don't
+// allocate. Despawning while iterating is safe: the handle goes stale and the object is skipped right away, but it's
+// only destroyed (and its slot reused) once the iteration is over.
+template <typename T, std::size_t CAPACITY>
+class ObjectPool {
+public:
+    ObjectPool()
+        : slots()
+        , free_slots()
+        , n_free(CAPACITY)
+        , despawned()
+        , n_despawned(0)
+        , iterating(0)
+    {
+        for (std::size_t i = 0; i < CAPACITY; ++i) {
+            this->free_slots[i] = std::uint32_t(CAPACITY - i - 1);
+        }
+    }
+
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    // Returns an invalid handle if the pool is full
+    template <typename... Args>
+    PoolHandle spawn(Args&&... args)
+    {
+        if (this->n_free == 0) {
+            return PoolHandle {};
+        }
+        auto const index = this->free_slots[--this->n_free];
+        auto& slot = this->slots[index];
+        slot.object.emplace(std::forward<Args>(args)...);
+        slot.alive = true;
+        return PoolHandle { index, slot.generation };
+    }
+
+    inline T* get(PoolHandle handle)
+    {
+        if (!this->is_alive(handle)) {
+            return nullptr;
+        }
+        return &*this->slots[handle.index].object;
+    }
+
+    void despawn(PoolHandle handle)
+    {
+        if (!this->is_alive(handle)) {
+            return;
+        }
+        auto& slot = this->slots[handle.index];
+        slot.alive = false;
+        slot.generation++;
+        if (this->iterating > 0) {
+            this->despawned[this->n_despawned++] = handle.index;
+        } else {
+            this->release(handle.index);
+        }
+    }
+
+    // Calls f(handle, object) for each object. Objects spawned meanwhile may or may not be visited.
+    template <typename F>
+    void for_each(F&& f)
+    {
+        this->iterating++;
+        for (std::size_t i = 0; i < CAPACITY; ++i) {
+            auto& slot = this->slots[i];
+            if (slot.alive) {
+                f(PoolHandle { std::uint32_t(i), slot.generation }, *slot.object);
+            }
+        }
+        if (--this->iterating == 0) {
+            while (this->n_despawned > 0) {
+                this->release(this->despawned[--this->n_despawned]);
+            }
+        }
+    }
+
+    inline std::size_t size() const
+    {
+        return CAPACITY - this->n_free - this->n_despawned;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return CAPACITY;
+    }
+
+private:
+    struct Slot {
+        std::optional<T> object;
+        std::uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    inline bool is_alive(PoolHandle handle) const
+    {
+        return handle.index < CAPACITY && this->slots[handle.index].alive
+            && this->slots[handle.index].generation == handle.generation;
+    }
+
+    void release(std::uint32_t index)
+    {
+        this->slots[index].object.reset();
+        this->free_slots[this->n_free++] = index;
+    }
+
+    std::array<Slot, CAPACITY> slots;
+    std::array<std::uint32_t, CAPACITY> free_slots;
+    std::size_t n_free;
+    // Despawned while iterating, destroyed once the iteration is over
+    std::array<std::uint32_t, CAPACITY> despawned;
+    std::size_t n_despawned;
+    int iterating;
+};
+
+#endif //PIGSGAME_OBJECTPOOL_HPP
@@ -0,0 +1,53 @@
+#include <ReleaseQueue.hpp>
+#include <algorithm>
+
+ReleaseQueue::ReleaseQueue()
+    : mutex()
+    , frame(0)
+    , released()
+{
+}
+
+void ReleaseQueue::begin_frame(std::uint64_t frame)
+{
+    auto lock = std::lock_guard(this->mutex);
+    this->frame = frame;
+}
+
+void ReleaseQueue::release(std::shared_ptr<void const> object)
+{
+    if (!object) {
+        return;
+    }
+    auto lock = std::lock_guard(this->mutex);
+    this->released.emplace_back(this->frame, std::move(object));
+}
+
+void ReleaseQueue::collect(std::uint64_t drawn_frame)
+{
+    auto collected = std::vector<std::shared_ptr<void const>>();
+    {
+        auto lock = std::lock_guard(this->mutex);
+        if (this->released.empty()) {
+            return;
+        }
+        auto still_drawn = std::stable_partition(this->released.begin(), this->released.end(),
+            [drawn_frame](auto const& entry) { return entry.first >= drawn_frame; });
+        for (auto it = still_drawn; it != this->released.end(); ++it) {
+            collected.push_back(std::move(it->second));
+        }
+        this->released.erase(still_drawn, this->released.end());
+    }
+    // Destroyed outside of the lock, not to block the simulation thread meanwhile
+}
+
+void ReleaseQueue::clear()
+{
+    auto collected = std::vector<std::pair<std::uint64_t, std::shared_ptr<void const>>>();
+    {
+        auto lock = std::lock_guard(this->mutex);
+        std::swap(collected, this->released);
+    }
+}
+
+ReleaseQueue release_queue;
@@ -0,0 +1,34 @@
+#ifndef PIGSGAME_RELEASEQUEUE_HPP
+#define PIGSGAME_RELEASEQUEUE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Objects released by the simulation thread while a frame recorded before may still be drawing them on the render
+// thread (a level and its tilemap cache, a texture...). They're destroyed on the render thread, once it draws a frame
+// recorded after their release.
+class ReleaseQueue {
+public:
+    ReleaseQueue();
+
+    // Simulation thread: the frame being simulated and recorded
+    void begin_frame(std::uint64_t frame);
+    void release(std::shared_ptr<void const> object);
+
+    // Render thread: destroys the objects released before `drawn_frame`
+    void collect(std::uint64_t drawn_frame);
+    // Destroys everything, once no frame is drawn anymore
+    void clear();
+
+private:
+    std::mutex mutex;
+    std::uint64_t frame;
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<void const>>> released;
+};
+
+extern ReleaseQueue release_queue;
+
+#endif //PIGSGAME_RELEASEQUEUE_HPP
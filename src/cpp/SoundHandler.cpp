@@ -1,24 +1,23 @@
 #include <SoundHandler.hpp>
+#include <AssetLoader.hpp>
+#include <AssetPack.hpp>
 #include <logging.hpp>
 
 namespace {
     Mix_Music* load_music(std::string const& filename)
     {
-        auto* music = Mix_LoadMUS(filename.c_str());
+        auto* music = static_cast<Mix_Music*>(nullptr);
+        if (auto entry = asset_pack.find(filename)) {
+            // Music is streamed from the mapped pack while playing, so it must be freed before the pack is closed
+            music = Mix_LoadMUS_RW(SDL_RWFromConstMem(entry->data.data(), static_cast<int>(entry->data.size())), 1);
+        } else {
+            music = Mix_LoadMUS(filename.c_str());
+        }
         if (!music) {
             warn("Unable to load music (filename="s + filename + ": "s + Mix_GetError());
         }
         return music;
     }
-
-    Mix_Chunk* load_sound(std::string const& filename)
-    {
-        auto* sound = Mix_LoadWAV(filename.c_str());
-        if (!sound) {
-            warn("Unable to load sound (filename="s + filename + ": "s + Mix_GetError());
-        }
-        return sound;
-    }
 }
 
 SoundHandler::SoundHandler()
@@ -34,12 +33,7 @@ SoundHandler::SoundHandler()
 
 SoundHandler::~SoundHandler()
 {
-    for (auto const& [_, music] : this->music_registry) {
-        Mix_FreeMusic(music);
-    }
-    for (auto const& [_, sound] : this->sound_registry) {
-        Mix_FreeChunk(sound);
-    }
+    this->unload();
 
     // From the SDL_mixer docs: Since each call to Mix_Init may set different flags,
     //     there is no way, currently, to request how many times each one was initted.
@@ -51,6 +45,19 @@ SoundHandler::~SoundHandler()
     }
 }
 
+void SoundHandler::unload()
+{
+    Mix_HaltMusic();
+    for (auto const& [_, music] : this->music_registry) {
+        Mix_FreeMusic(music);
+    }
+    for (auto const& [_, sound] : this->sound_registry) {
+        Mix_FreeChunk(sound);
+    }
+    this->music_registry.clear();
+    this->sound_registry.clear();
+}
+
 void SoundHandler::play_music(std::string const& music_name)
 {
     if (!this->music_registry.contains(music_name)) {
@@ -78,11 +85,19 @@ void SoundHandler::play(std::string const& sound_name)
 void SoundHandler::load()
 {
     using namespace std::string_literals;
+    // Music is streamed while playing, so opening it is cheap and stays on this thread
     for (auto const& filename : {"title_screen"s, "forest"s}) {
         this->music_registry[filename] = load_music("assets/music/"s + filename + ".ogg"s);
     }
-    for (auto const& filename : {"hit"s}) {
-        this->sound_registry[filename] = load_sound("assets/music/"s + filename + ".ogg"s);
+
+    auto const sound_names = std::vector { "hit"s };
+    auto sound_files = std::vector<std::string>();
+    for (auto const& name : sound_names) {
+        sound_files.push_back("assets/music/"s + name + ".ogg"s);
+    }
+    auto sounds = decode_sounds(sound_files);
+    for (std::size_t i = 0; i < sound_names.size(); ++i) {
+        this->sound_registry[sound_names[i]] = sounds[i];
     }
 }
 
@@ -11,6 +11,7 @@ public:
     ~SoundHandler();
 
     void load();
+    void unload();
     void play_music(std::string const& music_name);
     void play(std::string const& sound_name);
 
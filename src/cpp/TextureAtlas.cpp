@@ -0,0 +1,249 @@
+#include <AssetLoader.hpp>
+#include <AssetPack.hpp>
+#include <TextureAtlas.hpp>
+#include <logging.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+
+namespace {
+    // Skyline bottom-left rectangle packer: keeps the top outline of the packed rectangles as horizontal
+    // segments and places each new rectangle where its top ends up the lowest.
+    class SkylinePacker {
+    public:
+        SkylinePacker(int width, int height)
+            : width(width)
+            , height(height)
+            , skyline { { 0, 0, width } }
+        {
+        }
+
+        std::optional<Vector2D<int>> insert(int w, int h)
+        {
+            auto best_index = -1;
+            auto best_position = Vector2D<int> { 0, 0 };
+            auto best_top = this->height + 1;
+            for (int i = 0; i < int(this->skyline.size()); ++i) {
+                auto y = this->fit(i, w, h);
+                if (y && *y + h < best_top) {
+                    best_index = i;
+                    best_position = { this->skyline[i].x, *y };
+                    best_top = *y + h;
+                }
+            }
+            if (best_index == -1) {
+                return std::nullopt;
+            }
+
+            this->skyline.insert(this->skyline.begin() + best_index, { best_position.x, best_position.y + h, w });
+            auto right = best_position.x + w;
+            for (auto i = std::size_t(best_index + 1); i < this->skyline.size();) {
+                auto& segment = this->skyline[i];
+                if (segment.x >= right) {
+                    break;
+                }
+                auto shrink = right - segment.x;
+                segment.x += shrink;
+                segment.width -= shrink;
+                if (segment.width > 0) {
+                    break;
+                }
+                this->skyline.erase(this->skyline.begin() + i);
+            }
+            this->merge();
+            return best_position;
+        }
+
+    private:
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        // Lowest y in which a w x h rectangle can be placed starting at segment i
+        std::optional<int> fit(int i, int w, int h) const
+        {
+            if (this->skyline[i].x + w > this->width) {
+                return std::nullopt;
+            }
+            auto y = 0;
+            auto remaining = w;
+            for (auto j = std::size_t(i); remaining > 0; ++j) {
+                if (j == this->skyline.size()) {
+                    return std::nullopt;
+                }
+                y = std::max(y, this->skyline[j].y);
+                if (y + h > this->height) {
+                    return std::nullopt;
+                }
+                remaining -= this->skyline[j].width;
+            }
+            return y;
+        }
+
+        void merge()
+        {
+            for (std::size_t i = 0; i + 1 < this->skyline.size();) {
+                if (this->skyline[i].y == this->skyline[i + 1].y) {
+                    this->skyline[i].width += this->skyline[i + 1].width;
+                    this->skyline.erase(this->skyline.begin() + i + 1);
+                } else {
+                    ++i;
+                }
+            }
+        }
+
+        int width;
+        int height;
+        std::vector<Segment> skyline;
+    };
+}
+
+TextureAtlas::TextureAtlas()
+    : pages()
+    , entries()
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    this->clear();
+}
+
+void TextureAtlas::build(SDL_Renderer* renderer, std::vector<std::string> const& filenames)
+{
+    this->clear();
+
+    auto page_size = TextureAtlas::MAX_PAGE_SIZE;
+    auto renderer_info = SDL_RendererInfo {};
+    if (SDL_GetRendererInfo(renderer, &renderer_info) == 0 && renderer_info.max_texture_width > 0) {
+        page_size = std::min({ page_size, renderer_info.max_texture_width, renderer_info.max_texture_height });
+    }
+
+    auto surfaces = decode_images(filenames);
+    auto upload_start = std::chrono::steady_clock::now();
+
+    // Placing the tallest images first gives a much flatter skyline
+    auto order = std::vector<std::size_t>(filenames.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&surfaces](auto a, auto b) {
+        auto height = [&surfaces](auto i) { return surfaces[i] ? surfaces[i]->h : 0; };
+        return height(a) > height(b);
+    });
+
+    struct Placement {
+        std::size_t image;
+        std::size_t page;
+        Vector2D<int> position;
+    };
+    auto placements = std::vector<Placement>();
+    auto packers = std::vector<SkylinePacker>();
+    auto page_surfaces = std::vector<SDL_Surface*>();
+    for (auto i : order) {
+        auto* surface = surfaces[i];
+        if (surface == nullptr) {
+            continue;
+        }
+
+        auto w = surface->w + TextureAtlas::PADDING;
+        auto h = surface->h + TextureAtlas::PADDING;
+        if (w > page_size || h > page_size) {
+            warn("Image too large for the texture atlas: "s + filenames[i]);
+            continue;
+        }
+
+        auto placement = std::optional<Placement>();
+        for (std::size_t page = 0; page < packers.size() && !placement; ++page) {
+            if (auto position = packers[page].insert(w, h)) {
+                placement = Placement { i, page, *position };
+            }
+        }
+        if (!placement) {
+            packers.emplace_back(page_size, page_size);
+            page_surfaces.push_back(SDL_CreateRGBSurfaceWithFormat(0, page_size, page_size, 32, SDL_PIXELFORMAT_RGBA32));
+            placement = Placement { i, packers.size() - 1, *packers.back().insert(w, h) };
+        }
+        if (page_surfaces[placement->page] == nullptr) {
+            // Images placed on a page that couldn't be allocated are left out, so they are reported as missing
+            warn("Unable to allocate atlas page for "s + filenames[i] + ". SDL Error: "s + SDL_GetError());
+            continue;
+        }
+
+        auto dstrect = SDL_Rect { placement->position.x, placement->position.y, surface->w, surface->h };
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surface, nullptr, page_surfaces[placement->page], &dstrect);
+        placements.push_back(*placement);
+    }
+
+    auto page_textures = std::vector<SDL_Texture*>();
+    for (auto* page_surface : page_surfaces) {
+        auto* texture = static_cast<SDL_Texture*>(nullptr);
+        if (page_surface != nullptr) {
+            texture = SDL_CreateTextureFromSurface(renderer, page_surface);
+            SDL_FreeSurface(page_surface);
+            if (texture == nullptr) {
+                warn("Unable to create atlas page texture. SDL Error: "s + SDL_GetError());
+            }
+        }
+        if (texture != nullptr) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+            this->pages.push_back(texture);
+        }
+        page_textures.push_back(texture);
+    }
+    auto packed = std::size_t(0);
+    for (auto const& placement : placements) {
+        // Images on a page that failed to upload stay out of the entries as well
+        if (auto* page = page_textures[placement.page]; page != nullptr) {
+            this->entries[filenames[placement.image]] = SpriteSheet { page, placement.position };
+            ++packed;
+        }
+    }
+    for (auto* surface : surfaces) {
+        SDL_FreeSurface(surface);
+    }
+
+    auto upload_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - upload_start);
+    info("Packed "s + std::to_string(packed) + " images into "s + std::to_string(this->pages.size())
+        + " atlas page(s) in "s + std::to_string(upload_time.count()) + " ms"s);
+}
+
+void TextureAtlas::clear()
+{
+    for (auto* page : this->pages) {
+        SDL_DestroyTexture(page);
+    }
+    this->pages.clear();
+    this->entries.clear();
+}
+
+std::optional<SpriteSheet> TextureAtlas::find(std::string const& filename) const
+{
+    auto entry = this->entries.find(filename);
+    if (entry == this->entries.end()) {
+        return std::nullopt;
+    }
+    return entry->second;
+}
+
+std::vector<std::string> list_png_files(std::string const& directory)
+{
+    if (asset_pack.is_open()) {
+        return asset_pack.list(directory, ".png");
+    }
+
+    auto filenames = std::vector<std::string>();
+    auto error = std::error_code();
+    for (auto const& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".png") {
+            filenames.push_back(directory + entry.path().filename().string());
+        }
+    }
+    if (error) {
+        warn("Unable to list directory "s + directory + ": "s + error.message());
+    }
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+}
@@ -0,0 +1,40 @@
+#ifndef PIGSGAME_TEXTUREATLAS_HPP
+#define PIGSGAME_TEXTUREATLAS_HPP
+
+#include <sdl_wrappers.hpp>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Packs many images into a few large textures (pages), so that sprites from different sprite sheets can be
+// drawn without texture switches. Images are looked up by the same filename that would be given to load_media.
+class TextureAtlas {
+public:
+    static auto constexpr MAX_PAGE_SIZE = 2048;
+    static auto constexpr PADDING = 1;
+
+    TextureAtlas();
+    TextureAtlas(TextureAtlas const& other) = delete;
+    TextureAtlas& operator=(TextureAtlas const& other) = delete;
+    ~TextureAtlas();
+
+    void build(SDL_Renderer* renderer, std::vector<std::string> const& filenames);
+    void clear();
+    [[nodiscard]] std::optional<SpriteSheet> find(std::string const& filename) const;
+
+    inline std::size_t page_count() const
+    {
+        return this->pages.size();
+    }
+
+private:
+    std::vector<SDL_Texture*> pages;
+    std::unordered_map<std::string, SpriteSheet> entries;
+};
+
+// List of all PNG files in a directory (e.g. "assets/sprites/"), in a stable order. When an asset pack is open,
+// the images baked into it are listed instead.
+std::vector<std::string> list_png_files(std::string const& directory);
+
+#endif //PIGSGAME_TEXTUREATLAS_HPP
@@ -0,0 +1,70 @@
+#include <TileProperties.hpp>
+#include <AssetPack.hpp>
+#include <logging.hpp>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    std::optional<std::string> read_text(std::string const& filename)
+    {
+        if (auto entry = asset_pack.find(filename)) {
+            return std::string(reinterpret_cast<char const*>(entry->data.data()), entry->data.size());
+        }
+        auto file = std::ifstream(filename);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+        auto contents = std::stringstream();
+        contents << file.rdbuf();
+        return contents.str();
+    }
+}
+
+TilesetProperties::TilesetProperties()
+    : properties { TileProperties { CollisionType::NO_COLLISION, 0 } }
+{
+}
+
+void TilesetProperties::load(std::string const& filename)
+{
+    static auto const COLLISION_TYPES = std::unordered_map<std::string, CollisionType> {
+        { "none", CollisionType::NO_COLLISION },
+        { "solid", CollisionType::TILEMAP_COLLISION },
+        { "one_way", CollisionType::BOTTOM_ONLY_COLLISION },
+        { "dangerous", CollisionType::DANGEROUS_COLLISION },
+    };
+
+    auto contents = read_text(filename);
+    if (!contents) {
+        warn("Unable to read tileset properties (filename="s + filename + "), all tiles will be solid"s);
+        return;
+    }
+
+    auto lines = std::istringstream(*contents);
+    auto line = std::string();
+    auto line_number = 0;
+    while (std::getline(lines, line)) {
+        line_number++;
+        auto fields = std::istringstream(line);
+        auto tile_id = 0;
+        auto collision_name = std::string();
+        if (line.empty() || line[0] == '#' || !(fields >> tile_id)) {
+            continue;
+        }
+        fields >> collision_name;
+        auto callback_id = 0;
+        fields >> callback_id;
+
+        auto collision_type = COLLISION_TYPES.find(collision_name);
+        if (tile_id <= 0 || tile_id > UINT16_MAX || collision_type == COLLISION_TYPES.end()) {
+            warn("Invalid tileset property (filename="s + filename + ", line="s + std::to_string(line_number) + ")"s);
+            continue;
+        }
+        if (std::size_t(tile_id) >= this->properties.size()) {
+            this->properties.resize(tile_id + 1, TilesetProperties::SOLID_TILE);
+        }
+        this->properties[tile_id] = TileProperties { collision_type->second, std::uint16_t(callback_id) };
+    }
+}
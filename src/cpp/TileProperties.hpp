@@ -0,0 +1,40 @@
+#ifndef PIGSGAME_TILEPROPERTIES_HPP
+#define PIGSGAME_TILEPROPERTIES_HPP
+
+#include <GameMap.hpp>
+#include <collision/enums.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TileProperties {
+    CollisionType collision_type;
+    // Makes the tile a trigger zone with this callback id (0 for none), see TriggerZones
+    std::uint16_t callback_id;
+};
+
+// Properties of every tile of a tileset, in a dense array indexed by tile id. Loaded from a tileset metadata file
+// with one line per tile that isn't a plain solid tile:
+//
+//     <tile id> <none|solid|one_way|dangerous> [callback id]
+//
+// Empty lines and lines starting with '#' are ignored. Tile 0 is always empty (no collision).
+class TilesetProperties {
+public:
+    TilesetProperties();
+
+    // Keeps the default properties (every tile but 0 is solid) if the file can't be read
+    void load(std::string const& filename);
+
+    inline TileProperties const& operator[](TileId tile_id) const
+    {
+        return tile_id < this->properties.size() ? this->properties[tile_id] : TilesetProperties::SOLID_TILE;
+    }
+
+private:
+    static constexpr auto SOLID_TILE = TileProperties { CollisionType::TILEMAP_COLLISION, 0 };
+
+    std::vector<TileProperties> properties;
+};
+
+#endif //PIGSGAME_TILEPROPERTIES_HPP
@@ -0,0 +1,230 @@
+#include <TilemapChunkCache.hpp>
+#include <constants.hpp>
+#include <drawing.hpp>
+#include <logging.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    Vector2D<int> tileset_offset(int tile_id)
+    {
+        return { TILE_SIZE * (tile_id % 4), TILE_SIZE * int(floor(tile_id / 4)) };
+    }
+
+    // Same as draw_sprite, but straight into the sprite batch: the cache draws while draw lists are being submitted
+    void batch_sprite(SDL_Renderer* renderer, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
+        Vector2D<int> const& world_position, Vector2D<int> const& size, Vector2D<int> const& camera_offset)
+    {
+        auto srcrect = SDL_Rect { spritesheet.origin.x + sprite_offset.x, spritesheet.origin.y + sprite_offset.y, size.x, size.y };
+        auto camera_position = to_camera_position(world_position, size, camera_offset);
+        auto dstrect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * size.x, SCALE_SIZE * size.y };
+        sprite_batch.add(renderer, spritesheet.texture, srcrect, dstrect);
+    }
+}
+
+TilemapChunkCache::TilemapChunkCache(GameMap const& map, SpriteSheet const& tileset)
+    : map_width(map.width)
+    , map_height(map.height)
+    , tilemap(map.tilemap)
+    , tileset(tileset)
+    , n_chunks_x((map.width + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , n_chunks_y((map.height + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunks(n_chunks_x * n_chunks_y, Chunk { nullptr, true, 0 })
+    , n_baked_chunks(0)
+    , frame(0)
+{
+}
+
+TilemapChunkCache::~TilemapChunkCache()
+{
+    for (auto& chunk : this->chunks) {
+        if (chunk.texture != nullptr) {
+            SDL_DestroyTexture(chunk.texture);
+        }
+    }
+}
+
+void TilemapChunkCache::bake_all(SDL_Renderer* renderer)
+{
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return;
+    }
+    for (int chunk_y = 0; chunk_y < this->n_chunks_y; ++chunk_y) {
+        for (int chunk_x = 0; chunk_x < this->n_chunks_x; ++chunk_x) {
+            if (this->n_baked_chunks >= MAX_BAKED_CHUNKS) {
+                return;
+            }
+            if (this->chunk_at(chunk_x, chunk_y).dirty) {
+                this->bake(renderer, chunk_x, chunk_y);
+            }
+        }
+    }
+}
+
+void TilemapChunkCache::set_tile(int i, int j, TileId tile_id)
+{
+    this->tilemap.set(i, j, tile_id);
+    // Chunks are indexed bottom-up, as in world coordinates
+    auto world_row = this->map_height - i - 1;
+    this->chunk_at(j / CHUNK_SIZE, world_row / CHUNK_SIZE).dirty = true;
+}
+
+void TilemapChunkCache::fill(TileId tile_id)
+{
+    this->tilemap.fill(tile_id);
+    this->invalidate_all();
+}
+
+void TilemapChunkCache::invalidate_all()
+{
+    for (auto& chunk : this->chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void TilemapChunkCache::draw(SDL_Renderer* renderer, Region2D<int> const& visible_tiles,
+    Vector2D<int> const& camera_offset, Vector2D<int> const& shake)
+{
+    if (visible_tiles.w <= 0 || visible_tiles.h <= 0) {
+        return;
+    }
+
+    this->tilemap.page_in(visible_tiles.x, visible_tiles.x + visible_tiles.w - 1);
+    if (!SDL_RenderTargetSupported(renderer)) {
+        for (int i = visible_tiles.y; i < visible_tiles.y + visible_tiles.h; ++i) {
+            for (int j = visible_tiles.x; j < visible_tiles.x + visible_tiles.w; ++j) {
+                this->draw_tile(renderer, i, j, camera_offset, shake);
+            }
+        }
+        return;
+    }
+
+    this->frame++;
+    auto first_world_row = this->map_height - (visible_tiles.y + visible_tiles.h);
+    auto last_world_row = this->map_height - visible_tiles.y - 1;
+    for (int chunk_y = first_world_row / CHUNK_SIZE; chunk_y <= last_world_row / CHUNK_SIZE; ++chunk_y) {
+        for (int chunk_x = visible_tiles.x / CHUNK_SIZE; chunk_x <= (visible_tiles.x + visible_tiles.w - 1) / CHUNK_SIZE; ++chunk_x) {
+            auto& chunk = this->chunk_at(chunk_x, chunk_y);
+            if (chunk.dirty) {
+                this->bake(renderer, chunk_x, chunk_y);
+            }
+            chunk.last_drawn = this->frame;
+
+            auto tiles = this->chunk_tiles(chunk_x, chunk_y);
+            if (chunk.texture == nullptr) {
+                // The chunk texture couldn't be created, draw its visible tiles one by one instead
+                auto first_col = std::max(tiles.x, visible_tiles.x);
+                auto last_col = std::min(tiles.x + tiles.w, visible_tiles.x + visible_tiles.w);
+                for (int i = this->map_height - (tiles.y + tiles.h); i < this->map_height - tiles.y; ++i) {
+                    for (int j = first_col; j < last_col; ++j) {
+                        this->draw_tile(renderer, i, j, camera_offset, shake);
+                    }
+                }
+                continue;
+            }
+            auto world_position = Vector2D<int> { TILE_SIZE * tiles.x + shake.x, TILE_SIZE * tiles.y + shake.y };
+            auto size = Vector2D<int> { TILE_SIZE * tiles.w, TILE_SIZE * tiles.h };
+            batch_sprite(renderer, chunk.texture, { 0, 0 }, world_position, size, camera_offset);
+        }
+    }
+
+    while (this->n_baked_chunks > MAX_BAKED_CHUNKS && this->release_least_recently_drawn()) {
+    }
+}
+
+bool TilemapChunkCache::release_least_recently_drawn()
+{
+    auto* oldest = static_cast<Chunk*>(nullptr);
+    for (auto& chunk : this->chunks) {
+        if (chunk.texture != nullptr && (oldest == nullptr || chunk.last_drawn < oldest->last_drawn)) {
+            oldest = &chunk;
+        }
+    }
+    // Chunks drawn this frame are still referenced by the pending sprite batch
+    if (oldest == nullptr || oldest->last_drawn == this->frame) {
+        return false;
+    }
+    SDL_DestroyTexture(oldest->texture);
+    oldest->texture = nullptr;
+    oldest->dirty = true;
+    this->n_baked_chunks--;
+    return true;
+}
+
+TilemapChunkCache::Chunk& TilemapChunkCache::chunk_at(int chunk_x, int chunk_y)
+{
+    return this->chunks[chunk_y * this->n_chunks_x + chunk_x];
+}
+
+Region2D<int> TilemapChunkCache::chunk_tiles(int chunk_x, int chunk_y) const
+{
+    // Columns in x/w and world rows (bottom-up) in y/h
+    auto first_col = chunk_x * CHUNK_SIZE;
+    auto first_world_row = chunk_y * CHUNK_SIZE;
+    return {
+        first_col,
+        first_world_row,
+        std::min(CHUNK_SIZE, this->map_width - first_col),
+        std::min(CHUNK_SIZE, this->map_height - first_world_row)
+    };
+}
+
+void TilemapChunkCache::bake(SDL_Renderer* renderer, int chunk_x, int chunk_y)
+{
+    auto& chunk = this->chunk_at(chunk_x, chunk_y);
+    auto tiles = this->chunk_tiles(chunk_x, chunk_y);
+
+    if (chunk.texture == nullptr) {
+        chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            TILE_SIZE * tiles.w, TILE_SIZE * tiles.h);
+        if (chunk.texture == nullptr) {
+            warn("Unable to create tilemap chunk texture. SDL Error: "s + SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+        this->n_baked_chunks++;
+    }
+
+    // Pending quads must reach the current target (and may sample this chunk) before it is redrawn
+    sprite_batch.flush();
+
+    auto* previous_target = SDL_GetRenderTarget(renderer);
+    auto r = Uint8(0);
+    auto g = Uint8(0);
+    auto b = Uint8(0);
+    auto a = Uint8(0);
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    // Tiles never overlap, so they are copied as-is (no blending against the cleared chunk)
+    auto tileset_blend_mode = SDL_BLENDMODE_BLEND;
+    SDL_GetTextureBlendMode(this->tileset.texture, &tileset_blend_mode);
+    SDL_SetTextureBlendMode(this->tileset.texture, SDL_BLENDMODE_NONE);
+
+    SDL_SetRenderTarget(renderer, chunk.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    // Render chunks span the same columns as the tilemap chunks
+    this->tilemap.page_in(tiles.x, tiles.x + tiles.w - 1);
+    for (int row = 0; row < tiles.h; ++row) {
+        auto i = this->map_height - (tiles.y + row) - 1;
+        auto map_row = this->tilemap.row(i).subspan(tiles.x - this->tilemap.first_resident_column(), tiles.w);
+        for (int col = 0; col < tiles.w; ++col) {
+            auto offset = tileset_offset(map_row[col]);
+            auto srcrect = SDL_Rect { this->tileset.origin.x + offset.x, this->tileset.origin.y + offset.y, TILE_SIZE, TILE_SIZE };
+            auto dstrect = SDL_Rect { TILE_SIZE * col, TILE_SIZE * (tiles.h - row - 1), TILE_SIZE, TILE_SIZE };
+            SDL_RenderCopy(renderer, this->tileset.texture, &srcrect, &dstrect);
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_SetTextureBlendMode(this->tileset.texture, tileset_blend_mode);
+    chunk.dirty = false;
+}
+
+void TilemapChunkCache::draw_tile(SDL_Renderer* renderer, int i, int j, Vector2D<int> const& camera_offset,
+    Vector2D<int> const& shake)
+{
+    auto offset = tileset_offset(this->tilemap(i, j));
+    auto world_position = Vector2D<int> { TILE_SIZE * j + shake.x, TILE_SIZE * (this->map_height - i - 1) + shake.y };
+    batch_sprite(renderer, this->tileset, offset, world_position, { TILE_SIZE, TILE_SIZE }, camera_offset);
+}
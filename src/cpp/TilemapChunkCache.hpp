@@ -0,0 +1,61 @@
+#ifndef PIGSGAME_TILEMAPCHUNKCACHE_HPP
+#define PIGSGAME_TILEMAPCHUNKCACHE_HPP
+
+#include <GameMap.hpp>
+#include <Vector2D.hpp>
+#include <sdl_wrappers.hpp>
+#include <cstdint>
+#include <vector>
+
+// Keeps the tilemap pre-rendered in CHUNK_SIZE x CHUNK_SIZE tiles textures, so that drawing the map costs
+// a few texture copies per frame instead of one per tile. Chunks are re-baked lazily after being invalidated.
+// At most MAX_BAKED_CHUNKS textures are kept: the chunks drawn the longest ago are released first.
+// It draws straight into the sprite batch, so in the game it's only used on the render thread (see DrawList::add_tilemap).
+// It bakes from its own copy of the tile ids, paged in by the thread drawing it, so the render thread never reads
+// the level's tilemap while the simulation pages it.
+class TilemapChunkCache {
+public:
+    static auto constexpr CHUNK_SIZE = Tilemap::CHUNK_COLUMNS;
+    static auto constexpr MAX_BAKED_CHUNKS = 32;
+
+    TilemapChunkCache(GameMap const& map, SpriteSheet const& tileset);
+    TilemapChunkCache(TilemapChunkCache const& other) = delete;
+    TilemapChunkCache& operator=(TilemapChunkCache const& other) = delete;
+    ~TilemapChunkCache();
+
+    // Bakes every chunk (only the first MAX_BAKED_CHUNKS ones on large maps)
+    void bake_all(SDL_Renderer* renderer);
+    // Changes the cached copy of the tiles, for maps edited after the cache was created
+    void set_tile(int i, int j, TileId tile_id);
+    void fill(TileId tile_id);
+    // Re-bakes every chunk when next drawn, for when the renderer lost the content of its render targets
+    void invalidate_all();
+    void draw(SDL_Renderer* renderer, Region2D<int> const& visible_tiles, Vector2D<int> const& camera_offset,
+        Vector2D<int> const& shake = { 0, 0 });
+
+private:
+    struct Chunk {
+        SDL_Texture* texture;
+        bool dirty;
+        std::uint64_t last_drawn;
+    };
+
+    Chunk& chunk_at(int chunk_x, int chunk_y);
+    Region2D<int> chunk_tiles(int chunk_x, int chunk_y) const;
+    void bake(SDL_Renderer* renderer, int chunk_x, int chunk_y);
+    bool release_least_recently_drawn();
+    void draw_tile(SDL_Renderer* renderer, int i, int j, Vector2D<int> const& camera_offset, Vector2D<int> const& shake);
+
+private:
+    int map_width;
+    int map_height;
+    Tilemap tilemap;
+    SpriteSheet tileset;
+    int n_chunks_x;
+    int n_chunks_y;
+    std::vector<Chunk> chunks;
+    int n_baked_chunks;
+    std::uint64_t frame;
+};
+
+#endif //PIGSGAME_TILEMAPCHUNKCACHE_HPP
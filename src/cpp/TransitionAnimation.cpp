@@ -1,4 +1,6 @@
 #include <TransitionAnimation.hpp>
+#include <drawing.hpp>
+#include <utility>
 
 TransitionAnimation::TransitionAnimation()
     : animation_state(TransitionAnimationState::finished)
@@ -6,6 +8,7 @@ TransitionAnimation::TransitionAnimation()
     , transition_acceleration(0.0)
     , transition_velocity(0.0)
     , transition_width(0.0)
+    , transition_callback_done(true)
 {
 }
 
@@ -21,14 +24,28 @@ void TransitionAnimation::reset()
     this->transition_acceleration = 0.01;
     this->transition_velocity = 0.0;
     this->transition_width = 0.0;
+    this->transition_callback_done = false;
 }
 
 void TransitionAnimation::register_transition_callback(std::function<void()> const& f)
 {
     this->transition_callback = f;
+    this->transition_ready = nullptr;
 }
 
-void TransitionAnimation::run(SDL_Renderer* renderer, double elapsedTime)
+void TransitionAnimation::try_run_transition_callback()
+{
+    if (this->transition_callback_done || (this->transition_ready && !this->transition_ready())) {
+        return;
+    }
+    this->transition_callback_done = true;
+    this->transition_ready = nullptr;
+    if (auto callback = std::exchange(this->transition_callback, std::nullopt)) {
+        (*callback)();
+    }
+}
+
+void TransitionAnimation::run(DrawList& draw_list, double elapsedTime)
 {
     if (this->animation_state == TransitionAnimationState::blacking) {
         this->transition_velocity += this->transition_acceleration * elapsedTime;
@@ -38,24 +55,19 @@ void TransitionAnimation::run(SDL_Renderer* renderer, double elapsedTime)
             this->transition_width = SCREEN_WIDTH;
             this->transition_velocity = 0.0;
             this->animation_state = TransitionAnimationState::waiting;
-
-            if (this->transition_callback) {
-                (*this->transition_callback)();
-            }
+            this->try_run_transition_callback();
         }
 
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        auto rect = SDL_Rect { 0, 0, int(this->transition_width), SCREEN_HEIGHT };
-        SDL_RenderFillRect(renderer, &rect);
+        draw_list.add_filled(SDL_Rect { 0, 0, int(this->transition_width), SCREEN_HEIGHT }, SDL_Color { 0, 0, 0, 255 });
     } else if (this->animation_state == TransitionAnimationState::waiting) {
+        // Keeps waiting (black screen) for as long as the next level is still loading
+        this->try_run_transition_callback();
         this->wait_timeout -= elapsedTime;
-        if (this->wait_timeout <= 0.0) {
+        if (this->wait_timeout <= 0.0 && this->transition_callback_done) {
             this->animation_state = TransitionAnimationState::clearing;
         }
 
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-        auto rect = SDL_Rect { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
-        SDL_RenderFillRect(renderer, &rect);
+        draw_list.add_filled(SDL_Rect { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, SDL_Color { 0, 0, 0, 255 });
     } else if (this->animation_state == TransitionAnimationState::clearing) {
         this->transition_velocity += this->transition_acceleration * elapsedTime;
         this->transition_width -= this->transition_velocity * elapsedTime;
@@ -65,8 +77,7 @@ void TransitionAnimation::run(SDL_Renderer* renderer, double elapsedTime)
             this->animation_state = TransitionAnimationState::finished;
         }
 
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         auto rect = SDL_Rect { SCREEN_WIDTH - int(this->transition_width), 0, int(this->transition_width), SCREEN_HEIGHT };
-        SDL_RenderFillRect(renderer, &rect);
+        draw_list.add_filled(rect, SDL_Color { 0, 0, 0, 255 });
     }
 }
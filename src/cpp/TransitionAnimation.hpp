@@ -6,9 +6,14 @@
 #include <SDL_ttf.h>
 
 #include <constants.hpp>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <memory>
 #include <optional>
 
+class DrawList;
+
 enum class TransitionAnimationState {
     blacking = 0,
     waiting = 1,
@@ -20,10 +25,31 @@ class TransitionAnimation {
 public:
     TransitionAnimation();
     void reset();
+    // The callback runs once, when the screen is fully black
     void register_transition_callback(std::function<void()> const& f);
-    void run(SDL_Renderer* renderer, double elapsedTime);
+
+    // Starts `load` on a background thread right away. Once the screen is fully black and the loading is done,
+    // `on_loaded` is called with its result (on the simulation thread). The screen stays black until then.
+    template <typename T>
+    void register_transition_loader(
+        std::function<std::unique_ptr<T>()> const& load,
+        std::function<void(std::unique_ptr<T>&&)> const& on_loaded)
+    {
+        auto loading = std::make_shared<std::future<std::unique_ptr<T>>>(std::async(std::launch::async, load));
+        this->transition_callback = [loading, on_loaded]() {
+            on_loaded(loading->get());
+        };
+        this->transition_ready = [loading]() {
+            return loading->wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        };
+    }
+
+    void run(DrawList& draw_list, double elapsedTime);
     [[nodiscard]] TransitionAnimationState current_state() const;
 
+private:
+    void try_run_transition_callback();
+
 private:
     TransitionAnimationState animation_state;
     double wait_timeout;
@@ -31,6 +57,8 @@ private:
     double transition_velocity;
     double transition_width;
     std::optional<std::function<void()>> transition_callback;
+    std::function<bool()> transition_ready;
+    bool transition_callback_done;
 };
 
 #endif
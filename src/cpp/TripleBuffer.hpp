@@ -0,0 +1,54 @@
+#ifndef PIGSGAME_TRIPLEBUFFER_HPP
+#define PIGSGAME_TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Lock-free exchange of values between one writer and one reader thread. The writer always has a buffer of its own
+// to write to, and the reader always gets the last published one: neither of them ever waits for the other.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : buffers()
+        , back_index(0)
+        , middle(1)
+        , front_index(2)
+    {
+    }
+
+    // Writer side: the buffer to fill before publishing it. It still holds what was written three publications ago.
+    inline T& back()
+    {
+        return this->buffers[this->back_index];
+    }
+
+    inline void publish()
+    {
+        auto previous = this->middle.exchange(this->back_index | FRESH, std::memory_order_acq_rel);
+        this->back_index = previous & INDEX_MASK;
+    }
+
+    // Reader side: the last published buffer (the same one as before if nothing was published since)
+    inline T const& acquire()
+    {
+        if (this->middle.load(std::memory_order_relaxed) & FRESH) {
+            auto previous = this->middle.exchange(this->front_index, std::memory_order_acq_rel);
+            this->front_index = previous & INDEX_MASK;
+        }
+        return this->buffers[this->front_index];
+    }
+
+private:
+    static auto constexpr INDEX_MASK = std::uint8_t(0x3);
+    static auto constexpr FRESH = std::uint8_t(0x4);
+
+    std::array<T, 3> buffers;
+    std::uint8_t back_index;
+    // Index of the buffer between the writer and the reader, flagged FRESH when it hasn't been acquired yet
+    std::atomic<std::uint8_t> middle;
+    std::uint8_t front_index;
+};
+
+#endif //PIGSGAME_TRIPLEBUFFER_HPP
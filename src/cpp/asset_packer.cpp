@@ -0,0 +1,165 @@
+#include <SDL.h>
+#include <SDL_image.h>
+
+#include <AssetPack.hpp>
+#include <logging.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Bakes the game assets into a single asset pack (see AssetPack.hpp). Must run from the directory the game runs
+// from, so that the entries are named after the same paths the game uses to load the loose files.
+
+using namespace asset_pack_format;
+
+struct Options {
+    std::string output;
+    std::vector<std::string> directories;
+};
+
+struct PackedAsset {
+    std::string name;
+    AssetType type;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::vector<char> data;
+};
+
+Options handle_args(int argc, char* argv[])
+{
+    Options options { "assets.pack", {} };
+
+    for (int i = 1; i < argc; ++i) {
+        auto raw_arg = std::string(argv[i]);
+
+        if (raw_arg == "--output") {
+            if (i + 1 >= argc) {
+                std::cout << "Missing value for option: " << raw_arg << std::endl;
+                std::cout << "Usage: " << argv[0] << " [--output <filename>] [directory...]" << std::endl;
+                std::exit(1);
+            }
+            i++;
+            options.output = std::string(argv[i]);
+        } else {
+            options.directories.push_back(raw_arg.ends_with("/") ? raw_arg : raw_arg + "/");
+        }
+    }
+    if (options.directories.empty()) {
+        options.directories = { "assets/sprites/", "assets/music/", "maps/" };
+    }
+
+    return options;
+}
+
+std::vector<char> read_file(std::string const& filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::in);
+    if (!file.is_open()) {
+        err("Could not load file to read. filename="s + filename);
+    }
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+PackedAsset pack_image(std::string const& filename)
+{
+    auto* surface = IMG_Load(filename.c_str());
+    if (surface == nullptr) {
+        err("Unable to load image (filename="s + filename + "): "s + IMG_GetError());
+    }
+    auto* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (converted == nullptr) {
+        err("Unable to convert image (filename="s + filename + "): "s + SDL_GetError());
+    }
+
+    // Rows are stored tightly packed, regardless of the surface pitch
+    auto row_size = 4 * converted->w;
+    auto asset = PackedAsset { filename, AssetType::rgba32_image, std::uint32_t(converted->w), std::uint32_t(converted->h), {} };
+    asset.data.resize(std::size_t(row_size) * converted->h);
+    for (int row = 0; row < converted->h; ++row) {
+        auto const* source = static_cast<char const*>(converted->pixels) + std::size_t(row) * converted->pitch;
+        std::memcpy(asset.data.data() + std::size_t(row) * row_size, source, row_size);
+    }
+    SDL_FreeSurface(converted);
+    return asset;
+}
+
+std::vector<PackedAsset> collect_assets(std::vector<std::string> const& directories)
+{
+    auto assets = std::vector<PackedAsset>();
+    for (auto const& directory : directories) {
+        auto filenames = std::vector<std::string>();
+        for (auto const& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.is_regular_file()) {
+                filenames.push_back(directory + entry.path().filename().string());
+            }
+        }
+        std::sort(filenames.begin(), filenames.end());
+
+        for (auto const& filename : filenames) {
+            if (filename.ends_with(".png")) {
+                assets.push_back(pack_image(filename));
+            } else {
+                assets.push_back({ filename, AssetType::raw, 0, 0, read_file(filename) });
+            }
+        }
+    }
+    return assets;
+}
+
+void write_pack(std::vector<PackedAsset> const& assets, std::string const& filename)
+{
+    auto align = [](std::uint64_t offset) { return (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT; };
+
+    auto header = Header { MAGIC, VERSION, std::uint32_t(assets.size()) };
+    auto toc = std::vector<TocEntry>();
+    auto offset = std::uint64_t(sizeof(Header) + assets.size() * sizeof(TocEntry));
+    for (auto const& asset : assets) {
+        toc.push_back({ offset, 0, asset.data.size(), std::uint32_t(asset.name.size()), asset.type, asset.width, asset.height });
+        offset += asset.name.size();
+    }
+    for (auto& entry : toc) {
+        offset = align(offset);
+        entry.data_offset = offset;
+        offset += entry.data_size;
+    }
+
+    std::ofstream packfile(filename, std::ios::binary | std::ios::out);
+    if (!packfile.is_open()) {
+        err("Could not open file to write. filename="s + filename);
+    }
+    auto pad_to = [&packfile](std::uint64_t offset) {
+        while (std::uint64_t(packfile.tellp()) < offset) {
+            packfile.put('\0');
+        }
+    };
+
+    packfile.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+    packfile.write(reinterpret_cast<char const*>(toc.data()), toc.size() * sizeof(TocEntry));
+    for (auto const& asset : assets) {
+        packfile.write(asset.name.data(), asset.name.size());
+    }
+    for (std::size_t i = 0; i < assets.size(); ++i) {
+        pad_to(toc[i].data_offset);
+        packfile.write(assets[i].data.data(), assets[i].data.size());
+    }
+    packfile.close();
+
+    std::cout << "Packed " << assets.size() << " assets into " << filename << " (" << offset << " bytes)" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    auto options = handle_args(argc, argv);
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+        err("Failed to initialize PNG support: "s + IMG_GetError());
+    }
+    write_pack(collect_assets(options.directories), options.output);
+    IMG_Quit();
+    return 0;
+}
@@ -1,14 +1,18 @@
+#include <AssetsRegistry.hpp>
 #include <characters/Cannon.hpp>
+#include <logging.hpp>
 
-Cannon::Cannon(SDL_Renderer* renderer, double pos_x, double pos_y, int face)
-    : face(face)
-    , position { pos_x, pos_y }
+Cannon::Cannon(World& world, double pos_x, double pos_y, int face)
+    : IGameCharacter(world, CHARACTER_TYPE, { pos_x, pos_y }, collision_size, collision_layer::ENEMY, collision_layer::PLAYER)
+    , face(face)
     , is_attacking(false)
-    , renderer(renderer)
-    , spritesheet(load_media("assets/sprites/cannon96x96.png", renderer))
+    , spritesheet(assets_registry.acquire("assets/sprites/cannon96x96.png"))
+    , on_before_fire()
+    , fire_requested(false)
+    , cannon_balls()
 {
     auto register_animation = [&](int id, std::vector<std::tuple<int, int>> const& frames, double time) {
-        this->animations.insert(std::make_pair(id, Animation(this->spritesheet, frames, SPRITESHEET_OFFSET, 96, 96, time)));
+        this->animations.insert(std::make_pair(id, Animation(*this->spritesheet, frames, SPRITESHEET_OFFSET, 96, 96, time)));
     };
 
     register_animation(Cannon::IDLE_ANIMATION,
@@ -26,6 +30,12 @@ Cannon::Cannon(SDL_Renderer* renderer, double pos_x, double pos_y, int face)
         100.);
 }
 
+Cannon::~Cannon()
+{
+    // The balls live in this cannon's pool
+    this->cannon_balls.for_each([this](PoolHandle, CannonBall& cannon_ball) { this->world.destroy(cannon_ball.entity); });
+}
+
 void Cannon::set_on_before_fire(std::function<void()> const& f)
 {
     this->on_before_fire = f;
@@ -33,31 +43,17 @@ void Cannon::set_on_before_fire(std::function<void()> const& f)
 
 void Cannon::update(double elapsedTime)
 {
+    if (this->fire_requested) {
+        this->fire_requested = false;
+        // Spawning touches the world, which is only safe once the characters' update is over
+        this->world.defer(this->entity, [this]() { this->fire(); });
+    }
 }
 
 void Cannon::set_position(double x, double y)
 {
 }
 
-Vector2D<double> Cannon::get_position() const
-{
-    return this->position;
-}
-
-Vector2D<double> Cannon::get_velocity() const
-{
-    return { 0.0, 0.0 };
-}
-
-void Cannon::set_velocity(double x, double y)
-{
-}
-
-CollisionRegionInformation Cannon::get_collision_region_information() const
-{
-    return CollisionRegionInformation(this->position, this->position, this->collision_size);
-}
-
 void Cannon::handle_collision(CollisionType const& type, CollisionSide const& side)
 {
 }
@@ -75,11 +71,12 @@ void Cannon::trigger_attack()
         }
         this->animations.at(ATTACKING_ANIMATION).set_on_finish_animation_callback([this]() {
             this->is_attacking = false;
+            this->fire_requested = true;
         });
     }
 }
 
-void Cannon::run_animation(double elapsedTime, Vector2D<int> const& camera_offset)
+void Cannon::run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset)
 {
     auto current_animation = ([this]() {
         if (this->is_attacking) {
@@ -89,6 +86,17 @@ void Cannon::run_animation(double elapsedTime, Vector2D<int> const& camera_offse
     })();
 
     this->animations.at(current_animation)
-        .run(this->renderer, elapsedTime, this->face, Vector2D<int> { int(this->position.x), int(this->position.y) },
+        .run(draw_list, elapsedTime, this->face, this->get_render_position(interpolation).as_int(),
             camera_offset);
 }
+
+void Cannon::fire()
+{
+    auto const& position = this->get_position();
+    auto* cannon_ball = this->world.spawn_pooled(this->cannon_balls, position.x, position.y);
+    if (cannon_ball == nullptr) {
+        warn("Too many cannon balls in flight, not firing"s);
+        return;
+    }
+    cannon_ball->set_velocity(this->face * CANNON_BALL_SPEED, 0.0);
+}
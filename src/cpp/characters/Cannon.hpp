@@ -1,8 +1,11 @@
 #ifndef __CANNON_HPP
 #define __CANNON_HPP
 
+#include <AssetsRegistry.hpp>
 #include <Animation.hpp>
+#include <ObjectPool.hpp>
 #include <Vector2D.hpp>
+#include <characters/CannonBall.hpp>
 #include <characters/IGameCharacter.hpp>
 #include <sdl_wrappers.hpp>
 #include <tuple>
@@ -10,6 +13,7 @@
 
 class Cannon : public IGameCharacter {
 public:
+    static auto constexpr CHARACTER_TYPE = CharacterType::CANNON;
     static auto constexpr IDLE_ANIMATION = 0;
     static auto constexpr ATTACKING_ANIMATION = 1;
 
@@ -19,27 +23,31 @@ public:
 
     static auto constexpr SPRITESHEET_OFFSET = Vector2D<int> { 37, 32 };
 
-    Cannon(SDL_Renderer* renderer, double pos_x, double pos_y, int face);
+    static auto constexpr MAX_CANNON_BALLS = std::size_t(8);
+    static auto constexpr CANNON_BALL_SPEED = 0.3;
+
+    Cannon(World& world, double pos_x, double pos_y, int face);
+    ~Cannon();
     void set_on_before_fire(std::function<void()> const& f);
     void update(double elapsedTime) override;
     void set_position(double x, double y) override;
-    Vector2D<double> get_position() const override;
-    Vector2D<double> get_velocity() const override;
-    void set_velocity(double x, double y) override;
-    CollisionRegionInformation get_collision_region_information() const override;
     void handle_collision(CollisionType const& type, CollisionSide const& side) override;
     void on_after_collision() override;
     void trigger_attack();
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override;
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override;
+
+private:
+    void fire();
 
 public:
     std::map<int, Animation> animations;
     int face;
-    Vector2D<double> position;
     bool is_attacking;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
+    TextureRef spritesheet;
     std::optional<std::function<void()>> on_before_fire;
+    bool fire_requested;
+    // The balls in flight. They're given back to the pool once they've exploded.
+    ObjectPool<CannonBall, MAX_CANNON_BALLS> cannon_balls;
 };
 
 #endif
@@ -1,11 +1,13 @@
 #ifndef __CANNONBALL_HPP
 #define __CANNONBALL_HPP
 
+#include <AssetsRegistry.hpp>
+#include <Animation.hpp>
 #include <Vector2D.hpp>
 #include <characters/IGameCharacter.hpp>
 #include <sdl_wrappers.hpp>
+#include <array>
 #include <tuple>
-#include <vector>
 
 // TODO PIG-12: Initialize the camera on main (avoid global)
 extern Vector2D<int> camera_offset;
@@ -18,59 +20,46 @@ public:
         finished = 2
     };
 
-    static auto constexpr IDLE_ANIMATION = 0;
+    static auto constexpr CHARACTER_TYPE = CharacterType::CANNONBALL;
     static auto constexpr collision_size = Vector2D<int> { 20, 20 };
-
-    CannonBall(SDL_Renderer* renderer, double pos_x, double pos_y)
-        : animations()
-        , boom_animation(nullptr, {}, {0, 0}, 0, 0, 100.)
-        , position { pos_x, pos_y }
-        , old_position { pos_x, pos_y }
-        , velocity { 0.0,
-            0.0 }
+    static auto constexpr IDLE_FRAMES = std::array<std::tuple<int, int>, 1> { { { 0, 0 } } };
+    static auto constexpr BOOM_FRAMES = std::array<std::tuple<int, int>, 6> { {
+        { 0, 0 },
+        { 1, 0 },
+        { 2, 0 },
+        { 3, 0 },
+        { 4, 0 },
+        { 5, 0 },
+    } };
+
+    // Cannon balls are pooled (see Cannon): nothing here allocates, and they die once they finished exploding
+    CannonBall(World& world, double pos_x, double pos_y)
+        : IGameCharacter(world, CHARACTER_TYPE, { pos_x, pos_y }, collision_size, collision_layer::PROJECTILE,
+            collision_layer::PLAYER | collision_layer::ENEMY)
+        , idle_animation(assets_registry.cannonball, IDLE_FRAMES, Vector2D<int> { 20, 0 }, 44, 28, 1000., true)
+        , boom_animation(assets_registry.boom, BOOM_FRAMES, Vector2D<int> { 30, 27 }, 80, 80, 100., false)
         , state(CannonBallState::active)
-        , renderer(renderer)
-        , spritesheet(load_media("assets/sprites/cannonball44x28.png", renderer))
-        , boom_spritesheet(load_media("assets/sprites/boom80x80.png", renderer))
     {
-        auto register_animation = [&](int id, std::vector<std::tuple<int, int>> const& frames, double time) {
-            this->animations.insert(std::make_pair(id, Animation(this->spritesheet, frames, Vector2D<int> { 20, 0 }, 44, 28, time)));
-        };
-        register_animation(CannonBall::IDLE_ANIMATION,
-            {
-                { 0, 0 },
-            },
-            1000.);
-
-        this->boom_animation = Animation(this->boom_spritesheet,
-            {
-                { 0, 0 },
-                { 1, 0 },
-                { 2, 0 },
-                { 3, 0 },
-                { 4, 0 },
-                { 5, 0 },
-            },
-            Vector2D<int> { 30, 27 },
-            80, 80, 100.);
-
-        this->boom_animation.set_on_finish_animation_callback([this]() { this->state = CannonBallState::finished; });
+        world.velocities.add(this->entity, Velocity { 0.0, 0.0 });
+        world.healths.add(this->entity, Health { 1, false, false, true });
     }
 
     void update(double elapsedTime) override
     {
-        this->old_position = this->position;
-        this->position += this->velocity * elapsedTime;
     }
 
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override
     {
         if (this->state == CannonBallState::active) {
-            this->animations.at(IDLE_ANIMATION)
-                .run(this->renderer, elapsedTime, +1, this->position.as_int(), camera_offset);
-        } else if (this->state == CannonBallState::exploding) {
-            this->boom_animation.run(this->renderer, elapsedTime, +1, this->position.as_int(),
+            this->idle_animation.run(draw_list, elapsedTime, +1, this->get_render_position(interpolation).as_int(),
                 camera_offset);
+        } else if (this->state == CannonBallState::exploding) {
+            if (!this->boom_animation.run(draw_list, elapsedTime, +1, this->get_render_position(interpolation).as_int(),
+                    camera_offset)) {
+                this->state = CannonBallState::finished;
+                this->collider().enabled = false;
+                this->health().is_dead = true;
+            }
         }
     }
 
@@ -78,22 +67,6 @@ public:
     {
     }
 
-    Vector2D<double> get_position() const override
-    {
-        return this->position;
-    }
-
-    Vector2D<double> get_velocity() const override
-    {
-        return this->velocity;
-    }
-
-    void set_velocity(double x, double y) override
-    {
-        this->velocity.x = x;
-        this->velocity.y = y;
-    }
-
     void handle_collision(CollisionType const& type, CollisionSide const& side) override
     {
         if (type == CollisionType::TILEMAP_COLLISION) {
@@ -101,29 +74,14 @@ public:
         }
     }
 
-    CollisionRegionInformation get_collision_region_information() const override
-    {
-        if (this->state == CannonBallState::active || this->state == CannonBallState::exploding) {
-            return CollisionRegionInformation(this->position, this->old_position, CannonBall::collision_size);
-        } else {
-            return CollisionRegionInformation({ 0, 0 }, { 0, 0 }, { 0, 0 });
-        }
-    }
-
     void on_after_collision() override
     {
     }
 
 public:
-    std::map<int, Animation> animations;
-    Animation boom_animation;
-    Vector2D<double> position;
-    Vector2D<double> old_position;
-    Vector2D<double> velocity;
+    FrameAnimation idle_animation;
+    FrameAnimation boom_animation;
     CannonBallState state;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
-    SDL_Texture* boom_spritesheet;
 };
 
 #endif
@@ -0,0 +1,127 @@
+#ifndef __COMPONENT_POOL_HPP
+#define __COMPONENT_POOL_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using Entity = std::uint32_t;
+
+// Components of one type, packed in a dense array (a sparse set). Systems iterate the dense array directly; lookups
+// by entity go through the sparse array. Removing a component moves the last one into its slot, so the dense order
+// is the insertion order until something is removed.
+template <typename T>
+class ComponentPool {
+public:
+    static auto constexpr NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    T& add(Entity entity, T&& component)
+    {
+        assert(!this->contains(entity));
+        if (entity >= this->sparse.size()) {
+            this->sparse.resize(entity + 1, NO_INDEX);
+        }
+        this->sparse[entity] = std::uint32_t(this->components.size());
+        this->entities.push_back(entity);
+        return this->components.emplace_back(std::move(component));
+    }
+
+    void remove(Entity entity)
+    {
+        if (!this->contains(entity)) {
+            return;
+        }
+        auto const index = this->sparse[entity];
+        auto const last = Entity(this->entities.back());
+        this->components[index] = std::move(this->components.back());
+        this->entities[index] = last;
+        this->sparse[last] = index;
+        this->components.pop_back();
+        this->entities.pop_back();
+        this->sparse[entity] = NO_INDEX;
+    }
+
+    inline bool contains(Entity entity) const
+    {
+        return entity < this->sparse.size() && this->sparse[entity] != NO_INDEX;
+    }
+
+    inline T& get(Entity entity)
+    {
+        assert(this->contains(entity));
+        return this->components[this->sparse[entity]];
+    }
+
+    inline T const& get(Entity entity) const
+    {
+        assert(this->contains(entity));
+        return this->components[this->sparse[entity]];
+    }
+
+    inline T* find(Entity entity)
+    {
+        return this->contains(entity) ? &this->components[this->sparse[entity]] : nullptr;
+    }
+
+    inline T const* find(Entity entity) const
+    {
+        return this->contains(entity) ? &this->components[this->sparse[entity]] : nullptr;
+    }
+
+    // Position of the entity's component in the dense array, or NO_INDEX
+    inline std::uint32_t index_of(Entity entity) const
+    {
+        return this->contains(entity) ? this->sparse[entity] : NO_INDEX;
+    }
+
+    // Dense access, for the systems
+    inline std::size_t size() const
+    {
+        return this->components.size();
+    }
+
+    inline T& operator[](std::size_t i)
+    {
+        return this->components[i];
+    }
+
+    inline T const& operator[](std::size_t i) const
+    {
+        return this->components[i];
+    }
+
+    inline Entity entity(std::size_t i) const
+    {
+        return this->entities[i];
+    }
+
+    inline auto begin()
+    {
+        return this->components.begin();
+    }
+
+    inline auto end()
+    {
+        return this->components.end();
+    }
+
+    inline auto begin() const
+    {
+        return this->components.begin();
+    }
+
+    inline auto end() const
+    {
+        return this->components.end();
+    }
+
+private:
+    std::vector<std::uint32_t> sparse;
+    std::vector<Entity> entities;
+    std::vector<T> components;
+};
+
+#endif
@@ -2,22 +2,103 @@
 #define __GAME_CHARACTER_INTERFACE_HPP
 
 #include <Vector2D.hpp>
+#include <characters/World.hpp>
 #include <collision/CollisionRegion.hpp>
 #include <collision/enums.hpp>
 
+class DrawList;
+
+// Behaviour of an entity of the world. The character creates its entity and adds its transform and collider on
+// construction; the characters that move or can die add a velocity and a health too.
 class IGameCharacter {
 public:
+    IGameCharacter(World& world, CharacterType character_type, Vector2D<double> position, Vector2D<int> collision_size,
+        std::uint32_t collision_layer, std::uint32_t collision_mask)
+        : character_type(character_type)
+        , world(world)
+        , entity(world.create())
+    {
+        world.transforms.add(this->entity, Transform { position, position, position });
+        world.colliders.add(this->entity, Collider { collision_size, collision_layer, collision_mask, true });
+    }
+    IGameCharacter(IGameCharacter const&) = delete;
+    IGameCharacter& operator=(IGameCharacter const&) = delete;
+
     virtual ~IGameCharacter() = 0;
     virtual void update(double elapsedTime) = 0;
-    virtual void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) = 0;
-    virtual void set_position(double x, double y) = 0;
-    virtual Vector2D<double> get_position() const = 0;
-    virtual Vector2D<double> get_velocity() const = 0;
-    virtual void set_velocity(double x, double y) = 0;
+    virtual void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) = 0;
     virtual void handle_collision(CollisionType const& type, CollisionSide const& side) = 0;
-    virtual CollisionRegionInformation get_collision_region_information() const = 0;
     virtual void on_after_collision() = 0;
     // virtual int get_dynamic_property(int property_id) const = 0;
+
+    virtual void set_position(double x, double y)
+    {
+        this->transform().position = { x, y };
+    }
+
+    inline Vector2D<double> get_position() const
+    {
+        return this->transform().position;
+    }
+
+    inline Vector2D<double> get_velocity() const
+    {
+        auto const* velocity = this->world.velocities.find(this->entity);
+        return velocity != nullptr ? *velocity : Vector2D<double> { 0.0, 0.0 };
+    }
+
+    inline void set_velocity(double x, double y)
+    {
+        if (auto* velocity = this->world.velocities.find(this->entity)) {
+            *velocity = { x, y };
+        }
+    }
+
+    inline CollisionRegionInformation get_collision_region_information() const
+    {
+        return this->world.collision_region(this->entity);
+    }
+
+    // Position to draw the character at, between its previous and current simulation tick positions
+    inline Vector2D<double> get_render_position(double interpolation) const
+    {
+        auto const& transform = this->transform();
+        return transform.previous_tick_position + (transform.position - transform.previous_tick_position) * interpolation;
+    }
+
+    inline Transform& transform()
+    {
+        return this->world.transforms.get(this->entity);
+    }
+
+    inline Transform const& transform() const
+    {
+        return this->world.transforms.get(this->entity);
+    }
+
+    inline Velocity& velocity()
+    {
+        return this->world.velocities.get(this->entity);
+    }
+
+    inline Collider& collider()
+    {
+        return this->world.colliders.get(this->entity);
+    }
+
+    inline Health& health()
+    {
+        return this->world.healths.get(this->entity);
+    }
+
+    inline Health const& health() const
+    {
+        return this->world.healths.get(this->entity);
+    }
+
+    CharacterType character_type;
+    World& world;
+    Entity entity;
 };
 
 inline IGameCharacter::~IGameCharacter() {}
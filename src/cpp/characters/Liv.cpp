@@ -1,18 +1,15 @@
+#include <AssetsRegistry.hpp>
 #include <characters/Liv.hpp>
 #include <iostream>
 
-Liv::Liv(SDL_Renderer* renderer, double pos_x, double pos_y)
-    : running_side(0)
+Liv::Liv(World& world, double pos_x, double pos_y)
+    : IGameCharacter(world, CHARACTER_TYPE, { pos_x, pos_y }, collision_size, collision_layer::PLAYER, collision_layer::ENEMY | collision_layer::PROJECTILE | collision_layer::ITEM)
+    , running_side(0)
     , animations()
+    , jump_smokes()
     , after_taking_damage_timeout()
     , face(+1)
-    , life(2)
-    , old_position { pos_x, pos_y }
-    , position { pos_x, pos_y }
-    , velocity { 0.0, 0.0 }
-    , renderer(renderer)
-    , spritesheet(load_media("assets/sprites/liv23x26.png", renderer))
-    , jump_spritesheet(load_media("assets/sprites/jump-smoke.png", renderer))
+    , spritesheet(assets_registry.acquire("assets/sprites/liv23x26.png"))
     , is_jumping(false)
     , is_falling(true)
     , start_jumping(false)
@@ -20,15 +17,16 @@ Liv::Liv(SDL_Renderer* renderer, double pos_x, double pos_y)
     , just_touched_ground(false)
     , is_taking_damage(false)
     , after_taking_damage(false)
-    , is_dying(false)
-    , is_dead(false)
     , start_dashing(false)
     , dashing_timeout(-0.1)
     , no_dash_timeout(-0.1)
     , jump_count(0)
 {
+    world.velocities.add(this->entity, Velocity { 0.0, 0.0 });
+    world.healths.add(this->entity, Health { 2, false, false, false });
+
     auto register_animation = [&](int id, std::vector<std::tuple<int, int>> const& frames, double time) {
-        this->animations.insert(std::make_pair(id, Animation(this->spritesheet, frames, SPRITESHEET_OFFSET, FRAME_SIZE_X, FRAME_SIZE_Y, time)));
+        this->animations.insert(std::make_pair(id, Animation(*this->spritesheet, frames, SPRITESHEET_OFFSET, FRAME_SIZE_X, FRAME_SIZE_Y, time)));
     };
     register_animation(IDLE_ANIMATION,
         {
@@ -97,52 +95,25 @@ Liv::Liv(SDL_Renderer* renderer, double pos_x, double pos_y)
     });
     this->animations.at(TAKING_DAMAGE_ANIMATION).set_on_finish_animation_callback([this]() {
         this->is_taking_damage = false;
-        if (this->life > 0) {
+        if (this->health().life > 0) {
             this->after_taking_damage = true;
             this->after_taking_damage_timeout.restart();
         } else {
-            this->is_dying = true;
+            this->health().is_dying = true;
         }
     });
     this->after_taking_damage_timeout = StateTimeout(500., [this]() { this->after_taking_damage = false; });
     this->animations.at(DYING_ANIMATION).set_on_finish_animation_callback([this]() {
         this->is_taking_damage = false;
         this->after_taking_damage = false;
-        this->is_dying = false;
-        this->is_dead = true;
+        this->health().is_dying = false;
+        this->health().is_dead = true;
         if (this->on_dead_callback) {
             (*this->on_dead_callback)();
         }
     });
 }
 
-void Liv::set_position(double x, double y)
-{
-    this->position.x = x;
-    this->position.y = y;
-}
-
-Vector2D<double> Liv::get_position() const
-{
-    return this->position;
-}
-
-Vector2D<double> Liv::get_velocity() const
-{
-    return this->velocity;
-}
-
-void Liv::set_velocity(double x, double y)
-{
-    this->velocity.x = x;
-    this->velocity.y = y;
-}
-
-CollisionRegionInformation Liv::get_collision_region_information() const
-{
-    return CollisionRegionInformation(this->position, this->old_position, this->collision_size);
-}
-
 void Liv::handle_collision(const CollisionType& type, const CollisionSide& side)
 {
     if (type == CollisionType::TILEMAP_COLLISION && side == CollisionSide::TOP_COLLISION) {
@@ -162,16 +133,16 @@ void Liv::handle_collision(const CollisionType& type, const CollisionSide& side)
 
 void Liv::on_after_collision()
 {
-    this->is_falling = (!this->is_grounded && this->velocity.y < 0.0);
-    this->is_jumping = (!this->is_grounded && this->velocity.y > 0.0);
-    if (this->is_grounded && (this->position.y + 0.5) < this->old_position.y) {
+    this->is_falling = (!this->is_grounded && this->velocity().y < 0.0);
+    this->is_jumping = (!this->is_grounded && this->velocity().y > 0.0);
+    if (this->is_grounded && (this->transform().position.y + 0.5) < this->transform().old_position.y) {
         this->just_touched_ground = true;
     }
 }
 
 void Liv::handle_controller(GameController const& controller)
 {
-    if (this->is_taking_damage || this->is_dying || this->is_dead) {
+    if (this->is_taking_damage || this->health().is_dying || this->health().is_dead) {
         return;
     }
 
@@ -192,7 +163,7 @@ void Liv::handle_controller(GameController const& controller)
             (this->jump_count < 2 && this->is_falling)
         ) {
             if (this->is_grounded)  {
-                create_jump_animation();
+                create_jump_smoke();
             }
             this->start_jumping = true;
         }
@@ -218,17 +189,17 @@ void Liv::update(double elapsedTime)
     using SELF = Liv;
 
     // Update velocity x
-    if (!this->is_taking_damage && !this->is_dying && !this->is_dead) {
-        this->velocity.x = this->running_side * SELF::walk_speed;
+    if (!this->is_taking_damage && !this->health().is_dying && !this->health().is_dead) {
+        this->velocity().x = this->running_side * SELF::walk_speed;
 
         // Update velocity y
         if (this->start_jumping) {
             this->start_jumping = false;
             this->is_grounded = false;
             if (this->jump_count == 0) {
-                this->velocity.y = SELF::jump_speed;
+                this->velocity().y = SELF::jump_speed;
             } else if (this->jump_count == 1) {
-                this->velocity.y = SELF::double_jump_speed;
+                this->velocity().y = SELF::double_jump_speed;
             }
 
             // Cancel dashing
@@ -246,8 +217,8 @@ void Liv::update(double elapsedTime)
             this->start_dashing = false;
         }
         if (this->dashing_timeout > 0.0) {
-            this->velocity.x = this->face * Liv::dash_speed;
-            this->velocity.y = 0.0;
+            this->velocity().x = this->face * Liv::dash_speed;
+            this->velocity().y = 0.0;
             this->dashing_timeout -= elapsedTime;
             if (this->dashing_timeout <= 0.0) {
                 this->no_dash_timeout = Liv::reset_no_dash_timeout;
@@ -258,15 +229,13 @@ void Liv::update(double elapsedTime)
         }
     }
 
-    if (this->is_dead) {
-        this->velocity.x = 0.0;
+    if (this->health().is_dead) {
+        this->velocity().x = 0.0;
     }
-    this->velocity.y += gravity * elapsedTime;
+    this->velocity().y += gravity * elapsedTime;
 
-    // Update Position
-    this->old_position = this->position;
-    this->position += this->velocity * elapsedTime;
-    if (this->is_grounded && this->velocity.y < -0.1) {
+    // The position is integrated by the world, once every character was updated
+    if (this->is_grounded && this->velocity().y < -0.1) {
         this->is_grounded = false;
         this->jump_count += 1;
     }
@@ -276,24 +245,24 @@ void Liv::update(double elapsedTime)
 
 void Liv::start_taking_damage()
 {
-    this->velocity.x = -this->face * 0.05;
-    this->velocity.y = 0.1;
+    this->velocity().x = -this->face * 0.05;
+    this->velocity().y = 0.1;
     this->is_taking_damage = true;
-    this->life -= 1;
+    this->health().life -= 1;
     this->start_dashing = false;
     this->dashing_timeout = 0.0;
     if (this->on_start_taking_damage) {
-        (*this->on_start_taking_damage)();
+        this->world.defer(this->entity, *this->on_start_taking_damage);
     }
 }
 
-void Liv::run_animation(double elapsedTime, Vector2D<int> const& camera_offset)
+void Liv::run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset)
 {
     auto current_animation = ([this]() {
-        if (this->is_dead) {
+        if (this->health().is_dead) {
             return DEAD_ANIMATION;
         }
-        if (this->is_dying) {
+        if (this->health().is_dying) {
             return DYING_ANIMATION;
         }
         if (this->is_taking_damage) {
@@ -317,14 +286,17 @@ void Liv::run_animation(double elapsedTime, Vector2D<int> const& camera_offset)
         return IDLE_ANIMATION;
     })();
     this->animations.at(current_animation)
-        .run(this->renderer, elapsedTime, this->face, this->position.as_int(), camera_offset);
+        .run(draw_list, elapsedTime, this->face, this->get_render_position(interpolation).as_int(), camera_offset);
     for (auto& on_after_run_animation : this->on_after_run_animation_callbacks) {
-        on_after_run_animation(this->renderer, this, elapsedTime);
+        on_after_run_animation(draw_list, this, elapsedTime);
     }
 
-    for (auto& [jump_pos, jumpAnimation] : this->jump_animations) {
-        jumpAnimation->run(this->renderer, elapsedTime, +1, jump_pos.as_int(), camera_offset);
-    }
+    // Despawning while iterating is fine, the pool frees the slots once the loop is over
+    this->jump_smokes.for_each([&](PoolHandle handle, JumpSmoke& jump_smoke) {
+        if (!jump_smoke.animation.run(draw_list, elapsedTime, +1, jump_smoke.position, camera_offset)) {
+            this->jump_smokes.despawn(handle);
+        }
+    });
 }
 
 Region2D<double> Liv::attack_region() const
@@ -332,29 +304,11 @@ Region2D<double> Liv::attack_region() const
     return { 0, 0, 0, 0 };
 }
 
-void Liv::create_jump_animation()
+void Liv::create_jump_smoke()
 {
-    this->jump_animations.emplace_back(
-            Vector2D<double>{this->position.x - 5, this->position.y},
-            std::make_unique<Animation>(
-                    this->jump_spritesheet,
-                    std::vector<std::tuple<int, int>>{
-                            {0, 0},
-                            {0, 1},
-                            {0, 2},
-                            {0, 3},
-                            {0, 4},
-                            {0, 5},
-                    },
-                    Vector2D<int>{0, 0},
-                    21,
-                    4,
-                    50
-            )
-    );
-    auto const& [_, animation] = this->jump_animations.back();
-    auto animation_pos = this->jump_animations.size() - 1;
-    animation->set_on_finish_animation_callback([this, animation_pos](){
-        this->jump_animations.erase(this->jump_animations.begin() + static_cast<int>(animation_pos));
+    // Nothing to show if too many are already on screen
+    this->jump_smokes.spawn(JumpSmoke {
+        Vector2D<double> { this->transform().position.x - 5, this->transform().position.y }.as_int(),
+        FrameAnimation(assets_registry.jump_smoke, JUMP_SMOKE_FRAMES, Vector2D<int> { 0, 0 }, 21, 4, 50., false),
     });
 }
@@ -3,19 +3,23 @@
 
 #include <characters/IGameCharacter.hpp>
 #include <GameController.hpp>
+#include <AssetsRegistry.hpp>
 #include <Animation.hpp>
+#include <ObjectPool.hpp>
 #include <StateTimeout.hpp>
 #include <Vector2D.hpp>
 #include <sdl_wrappers.hpp>
 #include <random.hpp>
 #include <functional>
 #include <optional>
-#include <memory>
+#include <array>
+#include <tuple>
 
 extern Vector2D<int> camera_offset;
 
 class Liv : public IGameCharacter {
 public:
+    static auto constexpr CHARACTER_TYPE = CharacterType::LIV;
     static auto constexpr IDLE_ANIMATION = 0;
     static auto constexpr RUNNING_ANIMATION = 1;
     static auto constexpr JUMPING_ANIMATION = 2;
@@ -36,40 +40,43 @@ public:
     static auto constexpr double_jump_speed = 0.25;
     static auto constexpr reset_dash_timeout = 200.0;
     static auto constexpr reset_no_dash_timeout = 500.0;
+    static auto constexpr MAX_JUMP_SMOKES = std::size_t(8);
+    static auto constexpr JUMP_SMOKE_FRAMES = std::array<std::tuple<int, int>, 6> { {
+        { 0, 0 },
+        { 0, 1 },
+        { 0, 2 },
+        { 0, 3 },
+        { 0, 4 },
+        { 0, 5 },
+    } };
+
+    struct JumpSmoke {
+        Vector2D<int> position;
+        FrameAnimation animation;
+    };
 
 public:
-    Liv(SDL_Renderer* renderer, double pos_x, double pos_y);
-    void set_position(double x, double y) override;
-    [[nodiscard]] Vector2D<double> get_position() const override;
-    [[nodiscard]] Vector2D<double> get_velocity() const override;
-    void set_velocity(double x, double y) override;
-    [[nodiscard]] CollisionRegionInformation get_collision_region_information() const override;
+    Liv(World& world, double pos_x, double pos_y);
     void handle_collision(CollisionType const& type, CollisionSide const& side) override;
     void on_after_collision() override;
     void handle_controller(GameController const& controller);
     void register_on_dead_callback(std::function<void()> const& f);
     void update(double elapsedTime) override;
     void start_taking_damage();
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override;
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override;
     [[nodiscard]] Region2D<double> attack_region() const;
 
 private:
-    void create_jump_animation();
+    void create_jump_smoke();
 
 public:
     int running_side;
     std::map<int, Animation> animations;
-    std::vector<std::tuple<Vector2D<double>, std::unique_ptr<Animation>>> jump_animations;
-    std::vector<std::function<void(SDL_Renderer*, IGameCharacter*, double)>> on_after_run_animation_callbacks;
+    ObjectPool<JumpSmoke, MAX_JUMP_SMOKES> jump_smokes;
+    std::vector<std::function<void(DrawList&, IGameCharacter*, double)>> on_after_run_animation_callbacks;
     StateTimeout after_taking_damage_timeout;
     int face;
-    int life;
-    Vector2D<double> old_position;
-    Vector2D<double> position;
-    Vector2D<double> velocity;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
-    SDL_Texture* jump_spritesheet;
+    TextureRef spritesheet;
     bool is_jumping;
     bool is_falling;
     bool start_jumping;
@@ -77,8 +84,6 @@ public:
     bool just_touched_ground;
     bool is_taking_damage;
     bool after_taking_damage;
-    bool is_dying;
-    bool is_dead;
     bool start_dashing;
     double dashing_timeout;
     double no_dash_timeout;
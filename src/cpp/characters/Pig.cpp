@@ -1,28 +1,26 @@
 #include <AssetsRegistry.hpp>
 #include <SoundHandler.hpp>
 #include <characters/Pig.hpp>
+#include <collision/queries.hpp>
 #include <logging.hpp>
 
-Pig::Pig(SDL_Renderer* renderer, double pos_x, double pos_y)
-    : running_side(0)
-    , position { pos_x, pos_y }
-    , old_position { pos_x, pos_y }
-    , velocity { 0.0, 0.0 }
-    , renderer(renderer)
-    , spritesheet(load_media("assets/sprites/pig80x80.png", renderer))
+Pig::Pig(World& world, double pos_x, double pos_y)
+    : IGameCharacter(world, CHARACTER_TYPE, { pos_x, pos_y }, collision_size, collision_layer::ENEMY, collision_layer::PLAYER | collision_layer::PROJECTILE)
+    , running_side(0)
+    , spritesheet(assets_registry.acquire("assets/sprites/pig80x80.png"))
     , think_timeout(1000.)
     , is_taking_damage(false)
-    , life(2)
-    , is_dying(false)
-    , is_dead(false)
     , is_talking(false)
     , is_angry(false)
     , is_fear(false)
     , talking_message("")
     , talk_color { 0, 0, 0 }
 {
+    world.velocities.add(this->entity, Velocity { 0.0, 0.0 });
+    world.healths.add(this->entity, Health { 2, false, false, true });
+
     auto register_animation = [&](int id, std::vector<std::tuple<int, int>> const& frames, double time) {
-        this->animations.insert(std::make_pair(id, Animation(this->spritesheet, frames, SPRITESHEET_OFFSET, 80, 80, time)));
+        this->animations.insert(std::make_pair(id, Animation(*this->spritesheet, frames, SPRITESHEET_OFFSET, 80, 80, time)));
     };
 
     register_animation(Pig::IDLE_ANIMATION,
@@ -96,67 +94,15 @@ Pig::Pig(SDL_Renderer* renderer, double pos_x, double pos_y)
     this->connect_callbacks();
 }
 
-Pig::Pig(Pig const& other)
-{
-    this->running_side = other.running_side;
-
-    // Force callbacks re-connection, so that the lambda functions are up-to-date
-    // in relation to the lambda captures
-    this->animations = other.animations;
-    this->connect_callbacks();
-
-    this->face = other.face;
-    this->position = other.position;
-    this->old_position = other.old_position;
-    this->velocity = other.velocity;
-    this->renderer = other.renderer;
-    this->spritesheet = other.spritesheet;
-    this->think_timeout = other.think_timeout;
-    this->is_taking_damage = other.is_taking_damage;
-    this->life = other.life;
-    this->is_dying = other.is_dying;
-    this->is_dead = other.is_dead;
-    this->is_talking = other.is_talking;
-    this->is_angry = other.is_angry;
-    this->is_fear = other.is_fear;
-}
-
 Pig::~Pig()
 {
 }
 
-void Pig::set_position(double x, double y)
-{
-    this->position.x = x;
-    this->position.y = y;
-}
-
 void Pig::set_script(SceneScript&& s)
 {
     this->script = std::move(s);
 }
 
-Vector2D<double> Pig::get_position() const
-{
-    return this->position;
-}
-
-Vector2D<double> Pig::get_velocity() const
-{
-    return this->velocity;
-}
-
-void Pig::set_velocity(double x, double y)
-{
-    this->velocity.y = x;
-    this->velocity.y = y;
-}
-
-CollisionRegionInformation Pig::get_collision_region_information() const
-{
-    return CollisionRegionInformation(this->position, this->old_position, this->collision_size);
-}
-
 void Pig::handle_collision(CollisionType const& type, CollisionSide const& side)
 {
     if (type == CollisionType::DANGEROUS_COLLISION && side == CollisionSide::BOTTOM_COLLISION) {
@@ -169,42 +115,50 @@ void Pig::on_after_collision()
 }
 
 void Pig::update(double elapsedTime)
+{
+    // Scripts look at the other characters' scripts, so the scripted pigs are updated once the others are done
+    if (this->script) {
+        this->world.defer(this->entity, [this, elapsedTime]() { this->update_behaviour(elapsedTime); });
+        return;
+    }
+    this->update_behaviour(elapsedTime);
+}
+
+void Pig::update_behaviour(double elapsedTime)
 {
     // velocity x setup
-    if (!this->is_taking_damage && !this->is_dead && !this->is_dying) {
+    if (!this->is_taking_damage && !this->health().is_dead && !this->health().is_dying) {
         this->think(elapsedTime);
     } else {
         this->running_side = 0;
     }
 
     if (this->running_side == +1)
-        this->velocity.x = +0.05;
+        this->velocity().x = +0.05;
     else if (this->running_side == -1)
-        this->velocity.x = -0.05;
+        this->velocity().x = -0.05;
     else
-        this->velocity.x = 0.0;
-    this->velocity.y = velocity.y + gravity * elapsedTime;
-
-    // Position setup
-    this->old_position = this->position;
-    this->position += this->velocity * elapsedTime;
+        this->velocity().x = 0.0;
+    this->velocity().y = this->velocity().y + gravity * elapsedTime;
 }
 
 void Pig::start_taking_damage()
 {
-    this->velocity.x = 0.05;
-    this->velocity.y = -0.1;
+    this->velocity().x = 0.05;
+    this->velocity().y = -0.1;
     this->is_taking_damage = true;
-    if (this->on_start_taking_damage) {
-        (*this->on_start_taking_damage)();
-    }
-    sound_handler.play("hit");
+    this->world.defer(this->entity, [this]() {
+        if (this->on_start_taking_damage) {
+            (*this->on_start_taking_damage)();
+        }
+        sound_handler.play("hit");
+    });
 }
 
-void Pig::run_animation(double elapsed_time, Vector2D<int> const& camera_offset)
+void Pig::run_animation(DrawList& draw_list, double elapsed_time, double interpolation, Vector2D<int> const& camera_offset)
 {
     auto current_animation = ([this]() {
-        if (this->is_dying) {
+        if (this->health().is_dying) {
             return DYING_ANIMATION;
         }
         if (this->is_taking_damage) {
@@ -231,10 +185,9 @@ void Pig::run_animation(double elapsed_time, Vector2D<int> const& camera_offset)
         return IDLE_ANIMATION;
     })();
     this->animations.at(current_animation)
-        .run(this->renderer, elapsed_time, -this->face, Vector2D<int> { int(this->position.x), int(this->position.y) },
+        .run(draw_list, elapsed_time, -this->face, this->get_render_position(interpolation).as_int(),
             camera_offset);
     if (this->is_talking) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         auto player_world_position = this->get_position().as_int();
         auto player_camera_position = to_camera_position(player_world_position + Vector2D<int> { 10, 40 }, { 0, 0 }, camera_offset);
         // Talking area
@@ -244,55 +197,55 @@ void Pig::run_animation(double elapsed_time, Vector2D<int> const& camera_offset)
             (5 + int(this->talking_message.size()) * 6 + 5) * SCALE_SIZE,
             (5 + 6 * 1 + 5) * SCALE_SIZE,
         });
-        SDL_RenderFillRect(renderer, &rect);
+        draw_filled_region(draw_list, Region2D<int> { rect.x, rect.y, rect.w, rect.h }, RGBColor { 255, 255, 255 });
 
         {
             auto srcrect = SDL_Rect { 0, 0, 5, 4 };
             auto dstrect = SDL_Rect { rect.x - 5 * SCALE_SIZE, rect.y - 4 * SCALE_SIZE, 5 * SCALE_SIZE, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 20, 4, 1, 4 };
             auto dstrect = SDL_Rect { rect.x, rect.y - 4 * SCALE_SIZE, rect.w, 5 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 10, 0, 5, 4 };
             auto dstrect = SDL_Rect { rect.x + rect.w, rect.y - 4 * SCALE_SIZE, 5 * SCALE_SIZE, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 25, 0, 5, 1 };
             auto dstrect = SDL_Rect { rect.x + rect.w, rect.y, 5 * SCALE_SIZE, rect.h };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 15, 0, 5, 4 };
             auto dstrect = SDL_Rect { rect.x + rect.w, rect.y + rect.h, 5 * SCALE_SIZE, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 20, 0, 1, 4 };
             auto dstrect = SDL_Rect { rect.x, rect.y + rect.h, rect.w, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 5, 0, 5, 4 };
             auto dstrect = SDL_Rect { rect.x - 5 * SCALE_SIZE, rect.y + rect.h, 5 * SCALE_SIZE, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 25, 4, 5, 1 };
             auto dstrect = SDL_Rect { rect.x - 5 * SCALE_SIZE, rect.y, 5 * SCALE_SIZE, rect.h };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
         {
             auto srcrect = SDL_Rect { 0, 4, 5, 4 };
             auto dstrect = SDL_Rect { rect.x + 15 * SCALE_SIZE, rect.y + rect.h + 3 * SCALE_SIZE, 5 * SCALE_SIZE, 4 * SCALE_SIZE };
-            SDL_RenderCopy(renderer, assets_registry.talk_baloon, &srcrect, &dstrect);
+            draw_sprite_rect(draw_list, assets_registry.talk_baloon, srcrect, dstrect);
         }
 
-        gout(this->renderer, assets_registry.monogram, player_camera_position, this->talking_message, this->talk_color);
+        gout(draw_list, assets_registry.monogram, player_camera_position, this->talking_message, this->talk_color);
     }
 }
 
@@ -359,9 +312,35 @@ void Pig::think(double elapsed_time)
             }
             this->think_timeout = 1000.;
         }
+        // Wandering pigs turn back rather than walking into a wall or off a ledge
+        if (this->running_side != 0 && !this->can_walk_ahead()) {
+            if (this->running_side == +1) {
+                this->run_left();
+            } else {
+                this->run_right();
+            }
+        }
     }
 }
 
+bool Pig::can_walk_ahead() const
+{
+    auto const& static_colliders = this->world.static_colliders;
+    auto const& position = this->get_position();
+    auto const side = double(this->running_side);
+    auto const center = Vector2D<double> { position.x + collision_size.x / 2.0, position.y + collision_size.y / 2.0 };
+    auto const look_ahead = collision_size.x / 2.0 + LOOK_AHEAD_DISTANCE;
+    if (raycast_tiles(static_colliders, center, { side, 0.0 }, look_ahead)) {
+        return false;
+    }
+    // Ledges only matter on the ground
+    if (!first_tile_below(static_colliders, { center.x, position.y + 1.0 }, MAX_STEP_DOWN + 1.0)) {
+        return true;
+    }
+    auto const foot_ahead = Vector2D<double> { center.x + side * look_ahead, position.y + 1.0 };
+    return first_tile_below(static_colliders, foot_ahead, MAX_STEP_DOWN + 1.0).has_value();
+}
+
 int Pig::get_dynamic_property(int property_id) const
 {
     if (property_id == SceneScriptLinePropertyId) {
@@ -377,34 +356,10 @@ void Pig::connect_callbacks()
 {
     this->animations.at(TAKING_DAMAGE_ANIMATION).set_on_finish_animation_callback([this]() {
         this->is_taking_damage = false;
-        this->life -= 1;
-        if (this->life <= 0) {
-            this->is_dying = true;
+        this->health().life -= 1;
+        if (this->health().life <= 0) {
+            this->health().is_dying = true;
         }
     });
-    this->animations.at(DYING_ANIMATION).set_on_finish_animation_callback([this]() { this->is_dead = true; });
-}
-
-Pig& Pig::operator=(Pig const& other)
-{
-    this->running_side = other.running_side;
-
-    // Force callbacks re-connection, so that the lambda functions are up-to-date
-    // in relation to the lambda captures
-    this->animations = other.animations;
-    this->connect_callbacks();
-
-    this->face = other.face;
-    this->position = other.position;
-    this->old_position = other.old_position;
-    this->velocity = other.velocity;
-    this->renderer = other.renderer;
-    this->spritesheet = other.spritesheet;
-    this->think_timeout = other.think_timeout;
-    this->is_taking_damage = other.is_taking_damage;
-    this->life = other.life;
-    this->is_dying = other.is_dying;
-    this->is_dead = other.is_dead;
-
-    return *this;
+    this->animations.at(DYING_ANIMATION).set_on_finish_animation_callback([this]() { this->health().is_dead = true; });
 }
@@ -1,10 +1,12 @@
 #ifndef __PIG_HPP
 #define __PIG_HPP
 
+#include <AssetsRegistry.hpp>
 #include <Animation.hpp>
 #include <SceneScript.hpp>
 #include <Vector2D.hpp>
 #include <characters/IGameCharacter.hpp>
+#include <constants.hpp>
 #include <random.hpp>
 #include <sdl_wrappers.hpp>
 
@@ -13,6 +15,7 @@ extern Vector2D<int> camera_offset;
 
 class Pig : public IGameCharacter {
 public:
+    static auto constexpr CHARACTER_TYPE = CharacterType::PIG;
     static auto constexpr IDLE_ANIMATION = 0;
     static auto constexpr RUNNING_ANIMATION = 1;
     static auto constexpr TAKING_DAMAGE_ANIMATION = 2;
@@ -24,25 +27,20 @@ public:
 
     static auto constexpr collision_size = Vector2D<int> { 18, 18 };
     static auto constexpr SPRITESHEET_OFFSET = Vector2D<int> { 31, 33 };
+    // How far a wandering pig looks ahead for walls and ledges
+    static auto constexpr LOOK_AHEAD_DISTANCE = 4.0;
+    static auto constexpr MAX_STEP_DOWN = double(TILE_SIZE);
 
-    Pig(SDL_Renderer* renderer, double pos_x, double pos_y);
-    Pig(Pig const& other);
-
-    Pig& operator=(Pig const& other);
+    Pig(World& world, double pos_x, double pos_y);
 
     virtual ~Pig();
 
     void set_script(SceneScript&& s);
-    void set_position(double x, double y) override;
-    Vector2D<double> get_position() const override;
-    Vector2D<double> get_velocity() const override;
-    void set_velocity(double x, double y) override;
-    CollisionRegionInformation get_collision_region_information() const override;
     void handle_collision(CollisionType const& type, CollisionSide const& side) override;
     void on_after_collision() override;
     void update(double elapsedTime) override;
     void start_taking_damage();
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override;
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override;
     void think(double elapsedTime);
     int get_dynamic_property(int property_id) const;
     void run_left();
@@ -54,22 +52,17 @@ public:
     void set_fear(bool fear);
 
 private:
+    void update_behaviour(double elapsedTime);
+    bool can_walk_ahead() const;
     void connect_callbacks();
 
 public:
     int running_side;
     std::map<int, Animation> animations;
     int face;
-    Vector2D<double> position;
-    Vector2D<double> old_position;
-    Vector2D<double> velocity;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
+    TextureRef spritesheet;
     double think_timeout;
     bool is_taking_damage;
-    int life;
-    bool is_dying;
-    bool is_dead;
     bool is_talking;
     bool is_angry;
     bool is_fear;
@@ -1,19 +1,19 @@
+#include <AssetsRegistry.hpp>
 #include <characters/PigWithMatches.hpp>
 
-PigWithMatches::PigWithMatches(SDL_Renderer* renderer, double pos_x, double pos_y, int face, Cannon& cannon)
-    : face(face)
-    , position { pos_x, pos_y }
-    , old_position { pos_x, pos_y }
-    , velocity { 0.0, 0.0 }
-    , renderer(renderer)
-    , spritesheet(load_media("assets/sprites/pig_with_match96x96.png", renderer))
+PigWithMatches::PigWithMatches(World& world, double pos_x, double pos_y, int face, Cannon& cannon)
+    : IGameCharacter(world, CHARACTER_TYPE, { pos_x, pos_y }, collision_size, collision_layer::ENEMY, collision_layer::NONE)
+    , face(face)
+    , spritesheet(assets_registry.acquire("assets/sprites/pig_with_match96x96.png"))
     , think_timeout(PigWithMatches::DEFAULT_THINK_TIMEOUT)
     , start_attack(false)
     , preparing_next_match(false)
     , cannon(cannon)
 {
+    world.velocities.add(this->entity, Velocity { 0.0, 0.0 });
+
     auto register_animation = [&](int id, std::vector<std::tuple<int, int>> const& frames, double time) {
-        this->animations.insert(std::make_pair(id, Animation(this->spritesheet, frames, SPRITESHEET_OFFSET, 96, 96, time)));
+        this->animations.insert(std::make_pair(id, Animation(*this->spritesheet, frames, SPRITESHEET_OFFSET, 96, 96, time)));
     };
 
     register_animation(PigWithMatches::IDLE_ANIMATION,
@@ -46,33 +46,6 @@ PigWithMatches::PigWithMatches(SDL_Renderer* renderer, double pos_x, double pos_
     });
 }
 
-void PigWithMatches::set_position(double x, double y)
-{
-    this->position.x = x;
-    this->position.y = y;
-}
-
-Vector2D<double> PigWithMatches::get_position() const
-{
-    return this->position;
-}
-
-void PigWithMatches::set_velocity(double x, double y)
-{
-    this->velocity.x = x;
-    this->velocity.y = y;
-}
-
-Vector2D<double> PigWithMatches::get_velocity() const
-{
-    return this->velocity;
-}
-
-CollisionRegionInformation PigWithMatches::get_collision_region_information() const
-{
-    return CollisionRegionInformation(this->position, this->old_position, PigWithMatches::collision_size);
-}
-
 void PigWithMatches::handle_collision(CollisionType const& type, CollisionSide const& side)
 {
 }
@@ -84,13 +57,9 @@ void PigWithMatches::on_after_collision()
 void PigWithMatches::update(double elapsedTime)
 {
     this->think(elapsedTime);
-
-    // Position setup
-    this->old_position = this->position;
-    this->position += this->velocity * elapsedTime;
 }
 
-void PigWithMatches::run_animation(double elapsedTime, Vector2D<int> const& camera_offset)
+void PigWithMatches::run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset)
 {
     auto current_animation = ([this]() {
         if (this->start_attack) {
@@ -102,7 +71,7 @@ void PigWithMatches::run_animation(double elapsedTime, Vector2D<int> const& came
         return IDLE_ANIMATION;
     })();
     this->animations.at(current_animation)
-        .run(this->renderer, elapsedTime, -this->face, this->position.as_int(), camera_offset);
+        .run(draw_list, elapsedTime, -this->face, this->get_render_position(interpolation).as_int(), camera_offset);
 }
 
 void PigWithMatches::think(double elapsedTime)
@@ -1,6 +1,7 @@
 #ifndef __PIG_WITH_MATCHES_HPP
 #define __PIG_WITH_MATCHES_HPP
 
+#include <AssetsRegistry.hpp>
 #include <Animation.hpp>
 #include <Vector2D.hpp>
 #include <characters/Cannon.hpp>
@@ -12,6 +13,7 @@ extern Vector2D<int> camera_offset;
 
 class PigWithMatches : public IGameCharacter {
 public:
+    static auto constexpr CHARACTER_TYPE = CharacterType::PIG_WITH_MATCHES;
     static auto constexpr IDLE_ANIMATION = 0;
     static auto constexpr ACTIVATE_CANNON = 1;
     static auto constexpr PREPARE_NEXT_MATCH = 2;
@@ -22,27 +24,18 @@ public:
     static auto constexpr SPRITESHEET_OFFSET = Vector2D<int> { 39, 32 };
     static auto constexpr collision_size = Vector2D<int> { 18, 18 };
 
-    PigWithMatches(SDL_Renderer* renderer, double pos_x, double pos_y, int face, Cannon& cannon);
+    PigWithMatches(World& world, double pos_x, double pos_y, int face, Cannon& cannon);
 
-    void set_position(double x, double y) override;
-    Vector2D<double> get_position() const override;
-    void set_velocity(double x, double y) override;
-    Vector2D<double> get_velocity() const override;
-    CollisionRegionInformation get_collision_region_information() const override;
     void handle_collision(CollisionType const& type, CollisionSide const& side) override;
     void on_after_collision() override;
     void update(double elapsedTime) override;
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override;
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override;
     void think(double elapsedTime);
 
 public:
     std::map<int, Animation> animations;
     int face;
-    Vector2D<double> position;
-    Vector2D<double> old_position;
-    Vector2D<double> velocity;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
+    TextureRef spritesheet;
     double think_timeout;
     bool start_attack;
     bool preparing_next_match;
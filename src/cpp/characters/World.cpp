@@ -0,0 +1,142 @@
+#include <characters/IGameCharacter.hpp>
+#include <characters/World.hpp>
+#include <algorithm>
+#include <iterator>
+
+void CharacterDeleter::operator()(IGameCharacter* character) const
+{
+    if (this->despawn != nullptr) {
+        this->despawn(this->pool, this->handle);
+    } else {
+        delete character;
+    }
+}
+
+World::World(StaticColliders const& static_colliders)
+    : characters()
+    , transforms()
+    , velocities()
+    , colliders()
+    , healths()
+    , static_colliders(static_colliders)
+    , deferred()
+    , applied()
+    , next_entity(0)
+    , generations()
+    , free_entities()
+    , dead_entities()
+{
+}
+
+World::~World()
+{
+    // The characters reach their components until they're gone
+    while (this->characters.size() > 0) {
+        this->destroy(this->characters.entity(this->characters.size() - 1));
+    }
+}
+
+Entity World::create()
+{
+    if (!this->free_entities.empty()) {
+        auto entity = this->free_entities.back();
+        this->free_entities.pop_back();
+        return entity;
+    }
+    this->generations.push_back(0);
+    return this->next_entity++;
+}
+
+void World::destroy(Entity entity)
+{
+    // The character goes first, its destructor may still look at its components
+    if (auto* character = this->characters.find(entity)) {
+        auto destroyed = std::move(*character);
+        this->characters.remove(entity);
+    }
+    this->transforms.remove(entity);
+    this->velocities.remove(entity);
+    this->colliders.remove(entity);
+    this->healths.remove(entity);
+    this->generations[entity]++;
+    this->free_entities.push_back(entity);
+}
+
+CollisionRegionInformation World::collision_region(Entity entity) const
+{
+    auto const& transform = this->transforms.get(entity);
+    auto const* collider = this->colliders.find(entity);
+    if (collider == nullptr || !collider->enabled) {
+        return CollisionRegionInformation({ 0, 0 }, { 0, 0 }, { 0, 0 });
+    }
+    return CollisionRegionInformation(transform.position, transform.old_position, collider->size);
+}
+
+void World::defer(Entity entity, std::function<void()> call)
+{
+    auto const thread = JobSystem::current_thread();
+    if (thread < 0 || std::size_t(thread) >= this->deferred.size()) {
+        call();
+        return;
+    }
+    this->deferred[thread].push_back({ entity, std::move(call) });
+}
+
+void World::apply_deferred()
+{
+    this->applied.clear();
+    for (auto& calls : this->deferred) {
+        std::move(calls.begin(), calls.end(), std::back_inserter(this->applied));
+        calls.clear();
+    }
+    // A character is updated by a single thread, so its calls are already in order
+    std::stable_sort(this->applied.begin(), this->applied.end(), [this](auto const& a, auto const& b) {
+        return this->characters.index_of(a.entity) < this->characters.index_of(b.entity);
+    });
+    for (auto& deferred_call : this->applied) {
+        deferred_call.call();
+    }
+    this->applied.clear();
+}
+
+void World::update(double elapsed_time)
+{
+    this->snapshot_transforms();
+    this->parallel_for_each_character([elapsed_time](IGameCharacter* character) { character->update(elapsed_time); });
+    this->integrate(elapsed_time);
+}
+
+void World::snapshot_transforms()
+{
+    job_system.parallel_for(this->transforms.size(), COMPONENTS_PER_JOB, [this](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto& transform = this->transforms[i];
+            transform.previous_tick_position = transform.position;
+        }
+    });
+}
+
+void World::integrate(double elapsed_time)
+{
+    job_system.parallel_for(this->velocities.size(), COMPONENTS_PER_JOB, [this, elapsed_time](std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto& transform = this->transforms.get(this->velocities.entity(i));
+            transform.old_position = transform.position;
+            transform.position += this->velocities[i] * elapsed_time;
+        }
+    });
+}
+
+void World::destroy_dead()
+{
+    this->dead_entities.clear();
+    for (std::size_t i = 0; i < this->healths.size(); ++i) {
+        auto const& health = this->healths[i];
+        if (health.is_dead && health.destroy_when_dead) {
+            this->dead_entities.push_back(this->healths.entity(i));
+        }
+    }
+    for (auto entity : this->dead_entities) {
+        this->destroy(entity);
+    }
+}
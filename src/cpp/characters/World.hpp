@@ -0,0 +1,160 @@
+#ifndef __WORLD_HPP
+#define __WORLD_HPP
+
+#include <JobSystem.hpp>
+#include <ObjectPool.hpp>
+#include <Vector2D.hpp>
+#include <characters/ComponentPool.hpp>
+#include <collision/CollisionRegion.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class IGameCharacter;
+class StaticColliders;
+
+struct Transform {
+    Vector2D<double> position;
+    // Position before the last movement, swept against the tilemap by the collision code
+    Vector2D<double> old_position;
+    // Position at the start of the current simulation tick, to interpolate the rendering
+    Vector2D<double> previous_tick_position;
+};
+
+using Velocity = Vector2D<double>;
+
+struct Collider {
+    Vector2D<int> size;
+    std::uint32_t layer;
+    std::uint32_t mask;
+    // Disabled colliders are skipped by the collision and trigger systems
+    bool enabled;
+};
+
+struct Health {
+    int life;
+    bool is_dying;
+    bool is_dead;
+    // Whether the entity is destroyed once it's dead, or stays around (e.g. to respawn)
+    bool destroy_when_dead;
+};
+
+// Deletes a character, or gives it back to the object pool it was spawned in
+struct CharacterDeleter {
+    void (*despawn)(void* pool, PoolHandle handle) = nullptr;
+    void* pool = nullptr;
+    PoolHandle handle;
+
+    void operator()(IGameCharacter* character) const;
+};
+
+using CharacterPtr = std::unique_ptr<IGameCharacter, CharacterDeleter>;
+
+// The entities of a level, and their components. The hot, per-tick data (transforms, velocities, colliders, health)
+// lives in dense pools that the systems below walk in order; the behaviour of each entity (state machines,
+// animations, scripts) lives in its game character, which reaches its components through its entity.
+//
+// The systems run across the job system's threads. A character only touches its own components while it's updated
+// in parallel; anything reaching other entities, the level or the game (callbacks, sounds, scripts, spawns) goes
+// through defer(), and is applied once the loop is over, in the order of the characters whatever the thread count.
+class World {
+public:
+    static auto constexpr CHARACTERS_PER_JOB = std::size_t(16);
+    static auto constexpr COMPONENTS_PER_JOB = std::size_t(256);
+
+    explicit World(StaticColliders const& static_colliders);
+    World(World const&) = delete;
+    World& operator=(World const&) = delete;
+    ~World();
+
+    Entity create();
+    // Removes all the components of the entity, its game character included. Its id may be reused afterwards.
+    void destroy(Entity entity);
+
+    // Changes each time the entity id is freed, to tell an entity from a later one reusing its id
+    inline std::uint32_t generation(Entity entity) const
+    {
+        return this->generations[entity];
+    }
+
+    // Creates a game character, which adds its own components on construction
+    template <typename T, typename... Args>
+    T& spawn(Args&&... args)
+    {
+        auto* spawned = new T(*this, std::forward<Args>(args)...);
+        this->characters.add(spawned->entity, CharacterPtr(spawned));
+        return *spawned;
+    }
+
+    // Same, in an object pool (which must outlive the character). Returns nullptr if the pool is full.
+    template <typename T, std::size_t CAPACITY, typename... Args>
+    T* spawn_pooled(ObjectPool<T, CAPACITY>& pool, Args&&... args)
+    {
+        auto const handle = pool.spawn(*this, std::forward<Args>(args)...);
+        auto* spawned = pool.get(handle);
+        if (spawned == nullptr) {
+            return nullptr;
+        }
+        auto const despawn = [](void* pool, PoolHandle handle) {
+            static_cast<ObjectPool<T, CAPACITY>*>(pool)->despawn(handle);
+        };
+        this->characters.add(spawned->entity, CharacterPtr(spawned, CharacterDeleter { despawn, &pool, handle }));
+        return spawned;
+    }
+
+    CollisionRegionInformation collision_region(Entity entity) const;
+
+    // From a parallel loop over the characters, queues the call for after the loop. Called right away otherwise.
+    void defer(Entity entity, std::function<void()> call);
+
+    // Calls f(character) for each character, in parallel, then applies the deferred calls. Characters can't be
+    // spawned nor destroyed meanwhile (but from a deferred call).
+    template <typename F>
+    void parallel_for_each_character(F const& f)
+    {
+        this->deferred.resize(job_system.thread_count());
+        job_system.parallel_for(this->characters.size(), CHARACTERS_PER_JOB, [this, &f](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                f(this->characters[i].get());
+            }
+        });
+        this->apply_deferred();
+    }
+
+    // Systems. A simulation tick snapshots the transforms, updates the characters' behaviour, then moves everything
+    // that has a velocity.
+    void update(double elapsed_time);
+    void snapshot_transforms();
+    void integrate(double elapsed_time);
+    void destroy_dead();
+
+    ComponentPool<CharacterPtr> characters;
+    ComponentPool<Transform> transforms;
+    ComponentPool<Velocity> velocities;
+    ComponentPool<Collider> colliders;
+    ComponentPool<Health> healths;
+
+    // The level's merged tiles, for the characters' spatial queries (see collision/queries.hpp)
+    StaticColliders const& static_colliders;
+
+private:
+    struct DeferredCall {
+        Entity entity;
+        std::function<void()> call;
+    };
+
+    void apply_deferred();
+
+    // Per thread of the job system
+    std::vector<std::vector<DeferredCall>> deferred;
+    std::vector<DeferredCall> applied;
+    Entity next_entity;
+    // Indexed by entity
+    std::vector<std::uint32_t> generations;
+    std::vector<Entity> free_entities;
+    std::vector<Entity> dead_entities;
+};
+
+#endif
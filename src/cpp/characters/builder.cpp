@@ -5,29 +5,21 @@
 #include <items/Key.hpp>
 #include <characters/builder.hpp>
 
-std::vector<std::unique_ptr<IGameCharacter>> build_game_characters(SDL_Renderer* renderer, GameMap const& map)
+void build_game_characters(World& world, GameMap const& map)
 {
-    auto game_characters = std::vector<std::unique_ptr<IGameCharacter>>();
-    auto player = ([&map, &renderer]() -> std::unique_ptr<IGameCharacter> {
-        for (auto const& info : map.interactables) {
-            if (info.id == 0) {
-                return std::make_unique<Liv>(renderer, info.position.x, info.position.y);
-            }
+    for (auto const& info : map.interactables) {
+        if (info.id == 0) {
+            world.spawn<Liv>(info.position.x, info.position.y);
+            break;
         }
-        return nullptr;
-    })();
-    if (player) {
-        game_characters.push_back(std::move(player));
     }
 
     for (auto const& info : map.interactables) {
         if (info.id == 1) {
-            game_characters.push_back(std::make_unique<Pig>(renderer, info.position.x, info.position.y));
+            world.spawn<Pig>(info.position.x, info.position.y);
         }
         if (info.id == 4) {
-            game_characters.push_back(std::make_unique<Key>(renderer, info.position.x, info.position.y));
+            world.spawn<Key>(info.position.x, info.position.y);
         }
     }
-
-    return game_characters;
 }
@@ -1,13 +1,10 @@
 #ifndef __CHARACTER_BUILDER_HPP
 #define __CHARACTER_BUILDER_HPP
 
-#include <vector>
-#include <memory>
-
-class IGameCharacter;
-class SDL_Renderer;
+class World;
 class GameMap;
 
-std::vector<std::unique_ptr<IGameCharacter>> build_game_characters(SDL_Renderer* renderer, GameMap const& map);
+// Spawns the characters of the map's interactables into the world, the player first
+void build_game_characters(World& world, GameMap const& map);
 
 #endif
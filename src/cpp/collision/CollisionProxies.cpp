@@ -0,0 +1,127 @@
+#include <collision/CollisionProxies.hpp>
+#include <characters/IGameCharacter.hpp>
+#include <characters/World.hpp>
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+inline void push_hits(unsigned int bits, std::size_t first, std::vector<std::uint32_t>& hits)
+{
+    while (bits != 0) {
+        hits.push_back(std::uint32_t(first + std::countr_zero(bits)));
+        bits &= bits - 1;
+    }
+}
+} // namespace
+
+CollisionProxies::CollisionProxies()
+    : x()
+    , y()
+    , w()
+    , h()
+    , old_x()
+    , old_y()
+    , layer()
+    , mask()
+    , characters()
+    , max_width(0.0)
+    , order()
+{
+}
+
+void CollisionProxies::build(World const& world)
+{
+    // Walks the dense collider pool; the colliders without a character (none so far) are skipped too
+    this->order.clear();
+    for (std::size_t i = 0; i < world.colliders.size(); ++i) {
+        if (world.colliders[i].enabled && world.characters.contains(world.colliders.entity(i))) {
+            this->order.push_back(std::uint32_t(i));
+        }
+    }
+    auto const n = this->order.size();
+    auto const transform = [&world](std::uint32_t i) -> Transform const& {
+        return world.transforms.get(world.colliders.entity(i));
+    };
+    std::sort(this->order.begin(), this->order.end(), [&transform](std::uint32_t a, std::uint32_t b) {
+        return transform(a).position.x < transform(b).position.x;
+    });
+
+    for (auto* column : { &this->x, &this->y, &this->w, &this->h, &this->old_x, &this->old_y }) {
+        column->resize(n);
+    }
+    this->layer.resize(n);
+    this->mask.resize(n);
+    this->characters.resize(n);
+    this->max_width = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const entity = world.colliders.entity(this->order[i]);
+        auto const& collider = world.colliders[this->order[i]];
+        auto const& transform = world.transforms.get(entity);
+        this->x[i] = transform.position.x;
+        this->y[i] = transform.position.y;
+        this->w[i] = double(collider.size.x);
+        this->h[i] = double(collider.size.y);
+        this->old_x[i] = transform.old_position.x;
+        this->old_y[i] = transform.old_position.y;
+        this->layer[i] = collider.layer;
+        this->mask[i] = collider.mask;
+        this->characters[i] = world.characters.get(entity).get();
+        this->max_width = std::max(this->max_width, this->w[i]);
+    }
+}
+
+void CollisionProxies::overlapping(Region2D<double> const& region, std::size_t first, std::size_t last,
+    std::vector<std::uint32_t>& hits) const
+{
+    // Same test as check_aabb_collision(region, box), several boxes at a time
+    auto const left = region.x;
+    auto const right = region.x + region.w;
+    auto const bottom = region.y;
+    auto const top = region.y + region.h;
+    auto i = first;
+
+#if defined(__AVX__)
+    auto const left_v = _mm256_set1_pd(left);
+    auto const right_v = _mm256_set1_pd(right);
+    auto const bottom_v = _mm256_set1_pd(bottom);
+    auto const top_v = _mm256_set1_pd(top);
+    for (; i + 4 <= last; i += 4) {
+        auto const x_v = _mm256_loadu_pd(&this->x[i]);
+        auto const y_v = _mm256_loadu_pd(&this->y[i]);
+        auto const w_v = _mm256_loadu_pd(&this->w[i]);
+        auto const h_v = _mm256_loadu_pd(&this->h[i]);
+        auto overlap = _mm256_and_pd(
+            _mm256_cmp_pd(left_v, _mm256_add_pd(x_v, w_v), _CMP_LT_OQ), _mm256_cmp_pd(right_v, x_v, _CMP_GT_OQ));
+        overlap = _mm256_and_pd(overlap, _mm256_cmp_pd(bottom_v, _mm256_add_pd(y_v, h_v), _CMP_LT_OQ));
+        overlap = _mm256_and_pd(overlap, _mm256_cmp_pd(top_v, y_v, _CMP_GT_OQ));
+        push_hits(unsigned(_mm256_movemask_pd(overlap)), i, hits);
+    }
+#elif defined(__SSE2__)
+    auto const left_v = _mm_set1_pd(left);
+    auto const right_v = _mm_set1_pd(right);
+    auto const bottom_v = _mm_set1_pd(bottom);
+    auto const top_v = _mm_set1_pd(top);
+    for (; i + 2 <= last; i += 2) {
+        auto const x_v = _mm_loadu_pd(&this->x[i]);
+        auto const y_v = _mm_loadu_pd(&this->y[i]);
+        auto const w_v = _mm_loadu_pd(&this->w[i]);
+        auto const h_v = _mm_loadu_pd(&this->h[i]);
+        auto overlap = _mm_and_pd(_mm_cmplt_pd(left_v, _mm_add_pd(x_v, w_v)), _mm_cmpgt_pd(right_v, x_v));
+        overlap = _mm_and_pd(overlap, _mm_cmplt_pd(bottom_v, _mm_add_pd(y_v, h_v)));
+        overlap = _mm_and_pd(overlap, _mm_cmpgt_pd(top_v, y_v));
+        push_hits(unsigned(_mm_movemask_pd(overlap)), i, hits);
+    }
+#endif
+
+    for (; i < last; ++i) {
+        if (left < this->x[i] + this->w[i] && right > this->x[i] && bottom < this->y[i] + this->h[i] && top > this->y[i]) {
+            hits.push_back(std::uint32_t(i));
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef __COLLISION_PROXIES_HPP
+#define __COLLISION_PROXIES_HPP
+
+#include <Vector2D.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class IGameCharacter;
+class World;
+
+// Collision boxes of the enabled colliders of the world for the current frame, stored as a structure of arrays sorted by x, so that
+// one box can be tested against many at once (see overlapping). Built once per frame, after the characters were
+// moved and resolved against the tilemap; the proxies don't follow the characters after that.
+class CollisionProxies {
+public:
+    CollisionProxies();
+
+    void build(World const& world);
+
+    // Appends to `hits` the indices in [first, last) of the boxes overlapping the region
+    void overlapping(Region2D<double> const& region, std::size_t first, std::size_t last,
+        std::vector<std::uint32_t>& hits) const;
+
+    inline std::size_t size() const
+    {
+        return this->characters.size();
+    }
+
+    inline Region2D<double> region(std::size_t i) const
+    {
+        return { this->x[i], this->y[i], this->w[i], this->h[i] };
+    }
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> w;
+    std::vector<double> h;
+    std::vector<double> old_x;
+    std::vector<double> old_y;
+    std::vector<std::uint32_t> layer;
+    std::vector<std::uint32_t> mask;
+    std::vector<IGameCharacter*> characters;
+    // Width of the widest box, to find all the boxes overlapping an interval from the sorted x
+    double max_width;
+
+private:
+    std::vector<std::uint32_t> order;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __REGION_INDEX_HPP
+#define __REGION_INDEX_HPP
+
+#include <Vector2D.hpp>
+#include <collision/aabb.hpp>
+#include <constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Static items with a `region` member, indexed in buckets of BUCKET_COLUMNS tile columns, so that queries only look
+// at the items around the queried region. Items out of [0, width) go to the first or last bucket.
+template <typename T>
+class RegionIndex {
+public:
+    static auto constexpr BUCKET_COLUMNS = 8;
+
+    explicit RegionIndex(double width)
+        : items()
+        , buckets(std::max(1, int(std::ceil(width / (TILE_SIZE * BUCKET_COLUMNS)))))
+    {
+    }
+
+    std::uint32_t add(T const& item)
+    {
+        auto const index = std::uint32_t(this->items.size());
+        this->items.push_back(item);
+        auto const last_bucket = this->bucket_of(item.region.x + item.region.w);
+        for (auto bucket = this->bucket_of(item.region.x); bucket <= last_bucket; ++bucket) {
+            this->buckets[bucket].push_back(index);
+        }
+        return index;
+    }
+
+    // Appends to `hits` the indices of the items overlapping the region. Items merely touching the region are left
+    // out.
+    void query(Region2D<double> const& region, std::vector<std::uint32_t>& hits) const
+    {
+        auto const first_bucket = this->bucket_of(region.x);
+        auto const last_bucket = this->bucket_of(region.x + region.w);
+        for (auto bucket = first_bucket; bucket <= last_bucket; ++bucket) {
+            for (auto index : this->buckets[bucket]) {
+                auto const& item = this->items[index];
+                // An item spanning several of the queried buckets is only reported from the first one
+                if (bucket != std::max(first_bucket, this->bucket_of(item.region.x))) {
+                    continue;
+                }
+                if (check_aabb_collision(region, item.region)) {
+                    hits.push_back(index);
+                }
+            }
+        }
+    }
+
+    inline T const& operator[](std::uint32_t i) const
+    {
+        return this->items[i];
+    }
+
+    inline std::size_t size() const
+    {
+        return this->items.size();
+    }
+
+private:
+    int bucket_of(double x) const
+    {
+        auto const bucket = int(std::floor(x / (TILE_SIZE * BUCKET_COLUMNS)));
+        return std::clamp(bucket, 0, int(this->buckets.size()) - 1);
+    }
+
+    std::vector<T> items;
+    std::vector<std::vector<std::uint32_t>> buckets;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include <collision/StaticColliders.hpp>
+#include <GameMap.hpp>
+#include <TileProperties.hpp>
+#include <collision/tile_merging.hpp>
+#include <constants.hpp>
+#include <logging.hpp>
+
+namespace {
+// Thickness of the solid border around the map, large enough to cover anything a character could reach
+auto constexpr OUT_OF_MAP_BORDER = double(1 << 20);
+} // namespace
+
+StaticColliders::StaticColliders(GameMap const& map, TilesetProperties const& tileset_properties)
+    : colliders(TILE_SIZE * map.width)
+{
+    // Reads the whole map without paging it in
+    auto tiles = TilemapReader(map.tilemap);
+    auto const collision_type = [&](int row, int column) {
+        return tileset_properties[tiles(map.height - row - 1, column)].collision_type;
+    };
+    auto n_tiles = 0;
+    merge_tiles(map.width, map.height, collision_type, [&](int column, int row, int columns, int rows, std::uint32_t key) {
+        n_tiles += columns * rows;
+        this->colliders.add({ Region2D<double> { double(TILE_SIZE * column), double(TILE_SIZE * row),
+                                  double(TILE_SIZE * columns), double(TILE_SIZE * rows) },
+            CollisionType(key) });
+    });
+    auto const n_tile_colliders = this->colliders.size();
+
+    // Everything out of the map is solid
+    auto const width = double(TILE_SIZE * map.width);
+    auto const height = double(TILE_SIZE * map.height);
+    auto constexpr border = OUT_OF_MAP_BORDER;
+    this->colliders.add({ { -border, -border, width + 2 * border, border }, CollisionType::TILEMAP_COLLISION });
+    this->colliders.add({ { -border, height, width + 2 * border, border }, CollisionType::TILEMAP_COLLISION });
+    this->colliders.add({ { -border, 0.0, border, height }, CollisionType::TILEMAP_COLLISION });
+    this->colliders.add({ { width, 0.0, border, height }, CollisionType::TILEMAP_COLLISION });
+
+    info("Merged "s + std::to_string(n_tiles) + " collideable tiles into "s + std::to_string(n_tile_colliders)
+        + " static colliders"s);
+}
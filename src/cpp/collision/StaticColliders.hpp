@@ -0,0 +1,45 @@
+#ifndef __STATIC_COLLIDERS_HPP
+#define __STATIC_COLLIDERS_HPP
+
+#include <Vector2D.hpp>
+#include <collision/RegionIndex.hpp>
+#include <collision/enums.hpp>
+#include <cstdint>
+#include <vector>
+
+struct GameMap;
+class TilesetProperties;
+
+struct StaticCollider {
+    Region2D<double> region;
+    CollisionType collision_type;
+};
+
+// The collideable tiles of a map, merged into maximal rectangles of tiles with the same collision type, plus a solid
+// border all around the map.
+class StaticColliders {
+public:
+    StaticColliders(GameMap const& map, TilesetProperties const& tileset_properties);
+
+    // Appends to `hits` the indices of the colliders overlapping the region. Colliders merely touching the region
+    // are left out.
+    inline void query(Region2D<double> const& region, std::vector<std::uint32_t>& hits) const
+    {
+        this->colliders.query(region, hits);
+    }
+
+    inline StaticCollider const& operator[](std::uint32_t i) const
+    {
+        return this->colliders[i];
+    }
+
+    inline std::size_t size() const
+    {
+        return this->colliders.size();
+    }
+
+private:
+    RegionIndex<StaticCollider> colliders;
+};
+
+#endif
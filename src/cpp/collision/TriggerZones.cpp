@@ -0,0 +1,92 @@
+#include <collision/TriggerZones.hpp>
+#include <GameMap.hpp>
+#include <TileProperties.hpp>
+#include <characters/IGameCharacter.hpp>
+#include <characters/World.hpp>
+#include <collision/tile_merging.hpp>
+#include <constants.hpp>
+#include <algorithm>
+
+TriggerZones::TriggerZones(GameMap const& map, TilesetProperties const& tileset_properties)
+    : zones(TILE_SIZE * map.width)
+    , callbacks()
+    , occupancy()
+    , next_occupancy()
+    , hits()
+{
+    // Reads the whole map without paging it in
+    auto tiles = TilemapReader(map.tilemap);
+    auto triggers = TilemapReader(map.triggers);
+    auto const callback_id = [&](int row, int column) {
+        auto const i = map.height - row - 1;
+        auto const painted = triggers(i, column);
+        return painted != 0 ? painted : tileset_properties[tiles(i, column)].callback_id;
+    };
+    merge_tiles(map.width, map.height, callback_id, [&](int column, int row, int columns, int rows, std::uint32_t key) {
+        this->zones.add({ Region2D<double> { double(TILE_SIZE * column), double(TILE_SIZE * row),
+                              double(TILE_SIZE * columns), double(TILE_SIZE * rows) },
+            std::uint16_t(key) });
+    });
+}
+
+void TriggerZones::bind(std::uint16_t callback_id, TriggerCallback const& callback)
+{
+    if (callback_id >= this->callbacks.size()) {
+        this->callbacks.resize(callback_id + 1);
+    }
+    this->callbacks[callback_id] = callback;
+}
+
+void TriggerZones::update(World const& world)
+{
+    this->next_occupancy.clear();
+    for (std::size_t i = 0; i < world.colliders.size(); ++i) {
+        auto const entity = world.colliders.entity(i);
+        if (!world.characters.contains(entity)) {
+            continue;
+        }
+        auto const& collider = world.colliders[i];
+        if (!collider.enabled) {
+            continue;
+        }
+        auto const& position = world.transforms.get(entity).position;
+        this->hits.clear();
+        this->zones.query(Region2D<double> { position.x, position.y, double(collider.size.x), double(collider.size.y) },
+            this->hits);
+        for (auto zone : this->hits) {
+            this->next_occupancy.push_back({ entity, world.generation(entity), zone });
+        }
+    }
+    std::sort(this->next_occupancy.begin(), this->next_occupancy.end());
+
+    // Both lists are sorted, so the entered, left and still occupied zones come out of a single merge pass
+    auto before = this->occupancy.begin();
+    auto after = this->next_occupancy.begin();
+    while (before != this->occupancy.end() || after != this->next_occupancy.end()) {
+        if (after == this->next_occupancy.end() || (before != this->occupancy.end() && *before < *after)) {
+            this->fire(world, *before, TriggerEvent::EXIT);
+            ++before;
+        } else if (before == this->occupancy.end() || *after < *before) {
+            this->fire(world, *after, TriggerEvent::ENTER);
+            ++after;
+        } else {
+            this->fire(world, *after, TriggerEvent::INSIDE);
+            ++before;
+            ++after;
+        }
+    }
+    std::swap(this->occupancy, this->next_occupancy);
+}
+
+void TriggerZones::fire(World const& world, Occupancy const& occupancy, TriggerEvent event) const
+{
+    // Gone (or replaced by an entity reusing its id) since it entered the zone
+    auto const* character = world.characters.find(occupancy.entity);
+    if (character == nullptr || world.generation(occupancy.entity) != occupancy.generation) {
+        return;
+    }
+    auto const callback_id = this->zones[occupancy.zone].callback_id;
+    if (callback_id < this->callbacks.size() && this->callbacks[callback_id]) {
+        this->callbacks[callback_id](character->get(), event);
+    }
+}
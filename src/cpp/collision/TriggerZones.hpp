@@ -0,0 +1,71 @@
+#ifndef __TRIGGER_ZONES_HPP
+#define __TRIGGER_ZONES_HPP
+
+#include <Vector2D.hpp>
+#include <characters/ComponentPool.hpp>
+#include <collision/RegionIndex.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct GameMap;
+class TilesetProperties;
+class IGameCharacter;
+class World;
+
+enum class TriggerEvent {
+    ENTER = 0,
+    EXIT = 1,
+    // On every update after ENTER, for as long as the character stays in the zone
+    INSIDE = 2
+};
+
+using TriggerCallback = std::function<void(IGameCharacter* character, TriggerEvent event)>;
+
+struct TriggerZone {
+    Region2D<double> region;
+    std::uint16_t callback_id;
+};
+
+// Trigger zones of a map: the tiles with a callback id, painted in the map's trigger layer or given by the tileset
+// properties (the trigger layer wins), merged into maximal rectangles. Levels bind a callback to each callback id
+// once, and update() fires them as characters enter and leave the zones.
+class TriggerZones {
+public:
+    TriggerZones(GameMap const& map, TilesetProperties const& tileset_properties);
+
+    void bind(std::uint16_t callback_id, TriggerCallback const& callback);
+
+    // Resolves the zones overlapped by each enabled collider of the world, and fires the callbacks of the zones entered, left
+    // and still occupied since the last update, in the order of the entities. Characters that are gone don't get an exit event. Doesn't
+    // allocate once the buffers grew.
+    void update(World const& world);
+
+    inline std::size_t size() const
+    {
+        return this->zones.size();
+    }
+
+private:
+    // Keyed on the entity and its generation, so that an entity reusing the id of a destroyed one is a new occupant
+    struct Occupancy {
+        Entity entity;
+        std::uint32_t generation;
+        std::uint32_t zone;
+
+        auto operator<=>(Occupancy const& other) const = default;
+    };
+
+    void fire(World const& world, Occupancy const& occupancy, TriggerEvent event) const;
+
+    RegionIndex<TriggerZone> zones;
+    // Indexed by callback id
+    std::vector<TriggerCallback> callbacks;
+    // Sorted (character, zone) pairs of the last update, and the buffers to compute the next ones
+    std::vector<Occupancy> occupancy;
+    std::vector<Occupancy> next_occupancy;
+    std::vector<std::uint32_t> hits;
+};
+
+#endif
@@ -3,7 +3,9 @@
 #include <characters/Liv.hpp>
 #include <characters/Pig.hpp>
 #include <items/Key.hpp>
+#include <characters/World.hpp>
 #include <collision/character_collision.hpp>
+#include <array>
 
 void pig_liv_collision(Pig* pig_ptr, Liv* liv_ptr)
 {
@@ -13,7 +15,7 @@ void pig_liv_collision(Pig* pig_ptr, Liv* liv_ptr)
     auto const& pig_collision_region = pig.get_collision_region_information().collision_region;
     auto const& player_collision_region = player.get_collision_region_information().collision_region;
 
-    if (!player.is_taking_damage && !player.after_taking_damage && !player.is_dying && !player.is_dead && !pig.is_taking_damage && !pig.is_dying && !pig.is_dead) {
+    if (!player.is_taking_damage && !player.after_taking_damage && !player.health().is_dying && !player.health().is_dead && !pig.is_taking_damage && !pig.health().is_dying && !pig.health().is_dead) {
         if (check_aabb_collision(player_collision_region, pig_collision_region)) {
             player.start_taking_damage();
         }
@@ -29,7 +31,7 @@ void cannonball_liv_collision(CannonBall* cannon_ptr, Liv* liv_ptr)
 {
     auto& player = *liv_ptr;
     auto& cannonball = *cannon_ptr;
-    if (!player.is_taking_damage && !player.after_taking_damage && !player.is_dying && !player.is_dead) {
+    if (!player.is_taking_damage && !player.after_taking_damage && !player.health().is_dying && !player.health().is_dead) {
         auto cannonball_collision_region_info = cannonball.get_collision_region_information();
         auto cannonball_collision_region = cannonball_collision_region_info.collision_region;
 
@@ -47,7 +49,7 @@ void cannonball_pig_collision(CannonBall* cannon_ptr, Pig* pig_ptr)
     auto& pig = *pig_ptr;
     auto& cannonball = *cannon_ptr;
 
-    if (!pig.is_taking_damage && !pig.is_dying && !pig.is_dead) {
+    if (!pig.is_taking_damage && !pig.health().is_dying && !pig.health().is_dead) {
         auto const& cannonball_collision_region = cannonball.get_collision_region_information().collision_region;
         auto const& pig_collision_region = pig.get_collision_region_information().collision_region;
 
@@ -69,55 +71,72 @@ void item_liv_collision(Key* key_ptr, Liv* liv_ptr)
     }
 }
 
-void compute_characters_collisions(std::vector<std::unique_ptr<IGameCharacter>>& game_characters)
-{
-    for (int i = 0; i < game_characters.size(); ++i) {
-        for (int j = i + 1; j < game_characters.size(); ++j) {
-            auto* char_i = game_characters[i].get();
-            auto* char_j = game_characters[j].get();
-
-            if (false) {
-            }
+namespace {
+using CollisionHandler = void (*)(IGameCharacter*, IGameCharacter*);
+auto constexpr N_CHARACTER_TYPES = std::size_t(CharacterType::COUNT);
+using CollisionDispatchTable = std::array<std::array<CollisionHandler, N_CHARACTER_TYPES>, N_CHARACTER_TYPES>;
 
-            else if (dynamic_cast<Pig*>(char_i) && dynamic_cast<Liv*>(char_j)) {
-                pig_liv_collision(dynamic_cast<Pig*>(char_i), dynamic_cast<Liv*>(char_j));
-            } else if (dynamic_cast<Pig*>(char_j) && dynamic_cast<Liv*>(char_i)) {
-                pig_liv_collision(dynamic_cast<Pig*>(char_j), dynamic_cast<Liv*>(char_i));
-            }
+// Registers the handler for both orders of the pair
+template <typename A, typename B, void (*handler)(A*, B*)>
+void register_collision_handler(CollisionDispatchTable& table)
+{
+    table[std::size_t(A::CHARACTER_TYPE)][std::size_t(B::CHARACTER_TYPE)] = [](IGameCharacter* a, IGameCharacter* b) {
+        handler(static_cast<A*>(a), static_cast<B*>(b));
+    };
+    table[std::size_t(B::CHARACTER_TYPE)][std::size_t(A::CHARACTER_TYPE)] = [](IGameCharacter* b, IGameCharacter* a) {
+        handler(static_cast<A*>(a), static_cast<B*>(b));
+    };
+}
 
-            else if (dynamic_cast<Cannon*>(char_i) && dynamic_cast<Liv*>(char_j)) {
-                cannon_liv_collision(dynamic_cast<Cannon*>(char_i), dynamic_cast<Liv*>(char_j));
-            } else if (dynamic_cast<Cannon*>(char_j) && dynamic_cast<Liv*>(char_i)) {
-                cannon_liv_collision(dynamic_cast<Cannon*>(char_j), dynamic_cast<Liv*>(char_i));
-            }
+CollisionDispatchTable const& collision_dispatch_table()
+{
+    static auto const table = []() {
+        auto table = CollisionDispatchTable {};
+        register_collision_handler<Pig, Liv, pig_liv_collision>(table);
+        register_collision_handler<Cannon, Liv, cannon_liv_collision>(table);
+        register_collision_handler<CannonBall, Liv, cannonball_liv_collision>(table);
+        register_collision_handler<CannonBall, Pig, cannonball_pig_collision>(table);
+        register_collision_handler<Key, Liv, item_liv_collision>(table);
+        return table;
+    }();
+    return table;
+}
+} // namespace
 
-            else if (dynamic_cast<CannonBall*>(char_i) && dynamic_cast<Liv*>(char_j)) {
-                cannonball_liv_collision(dynamic_cast<CannonBall*>(char_i), dynamic_cast<Liv*>(char_j));
-            } else if (dynamic_cast<CannonBall*>(char_j) && dynamic_cast<Liv*>(char_i)) {
-                cannonball_liv_collision(dynamic_cast<CannonBall*>(char_j), dynamic_cast<Liv*>(char_i));
-            }
+CharacterCollisionStats compute_characters_collisions(World& world, CollisionProxies& proxies)
+{
+    world.destroy_dead();
+    proxies.build(world);
+
+    // Broadphase: sort and sweep on x. The boxes that start before the end of the current one are tested against it
+    // in one go, and only the overlapping pairs whose collision layers interact reach the narrowphase handlers. These
+    // can't move characters, so the proxies stay valid for the whole sweep.
+    static auto hits = std::vector<std::uint32_t>();
+    auto const& dispatch_table = collision_dispatch_table();
+    auto const n = proxies.size();
+    auto stats = CharacterCollisionStats { int(n), 0, 0 };
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const right = proxies.x[i] + proxies.w[i];
+        auto last = i + 1;
+        while (last < n && proxies.x[last] < right) {
+            ++last;
+        }
+        stats.pairs_tested += int(last - i - 1);
 
-            else if (dynamic_cast<CannonBall*>(char_i) && dynamic_cast<Pig*>(char_j)) {
-                cannonball_pig_collision(dynamic_cast<CannonBall*>(char_i), dynamic_cast<Pig*>(char_j));
-            } else if (dynamic_cast<CannonBall*>(char_j) && dynamic_cast<Pig*>(char_i)) {
-                cannonball_pig_collision(dynamic_cast<CannonBall*>(char_j), dynamic_cast<Pig*>(char_i));
+        hits.clear();
+        proxies.overlapping(proxies.region(i), i + 1, last, hits);
+        for (auto j : hits) {
+            if (!(proxies.mask[i] & proxies.layer[j]) || !(proxies.mask[j] & proxies.layer[i])) {
+                continue;
             }
-
-            else if (dynamic_cast<Key*>(char_i) && dynamic_cast<Liv*>(char_j)) {
-                item_liv_collision(dynamic_cast<Key*>(char_i), dynamic_cast<Liv*>(char_j));
-            } else if (dynamic_cast<Key*>(char_j) && dynamic_cast<Liv*>(char_i)) {
-                item_liv_collision(dynamic_cast<Key*>(char_j), dynamic_cast<Liv*>(char_i));
+            stats.pairs_collided++;
+            auto* char_i = proxies.characters[i];
+            auto* char_j = proxies.characters[j];
+            auto handler = dispatch_table[std::size_t(char_i->character_type)][std::size_t(char_j->character_type)];
+            if (handler != nullptr) {
+                handler(char_i, char_j);
             }
         }
     }
-
-    game_characters.erase(std::remove_if(game_characters.begin(), game_characters.end(),
-                              [](std::unique_ptr<IGameCharacter>& c) {
-                                  auto* pig = dynamic_cast<Pig*>(c.get());
-                                  if (pig != nullptr) {
-                                      return pig->is_dead;
-                                  }
-                                  return false;
-                              }),
-        game_characters.end());
+    return stats;
 }
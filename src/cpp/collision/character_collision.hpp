@@ -1,10 +1,23 @@
 #ifndef __CHARACTERS_COLLISION
 #define __CHARACTERS_COLLISION
 
+#include <collision/CollisionProxies.hpp>
 #include <collision/aabb.hpp>
 #include <vector>
 #include <memory>
 
-void compute_characters_collisions(std::vector<std::unique_ptr<IGameCharacter>>& game_characters);
+class World;
+
+// Counters of the last call to compute_characters_collisions
+struct CharacterCollisionStats {
+    int characters;
+    // Pairs that made it through the broadphase
+    int pairs_tested;
+    // Pairs whose collision regions actually overlapped, and whose collision layers interact
+    int pairs_collided;
+};
+
+// Destroys the dead entities, rebuilds the collision proxies and runs the character vs character collisions
+CharacterCollisionStats compute_characters_collisions(World& world, CollisionProxies& proxies);
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef __COLLISION_ENUMS_HPP
 #define __COLLISION_ENUMS_HPP
 
+#include <cstdint>
+
 enum class CollisionType {
     NO_COLLISION = 0,
     TILEMAP_COLLISION = 1,
@@ -15,4 +17,24 @@ enum class CollisionSide {
     BOTTOM_COLLISION = 3
 };
 
+// Concrete type of a game character, used to dispatch character collisions without dynamic_casts
+enum class CharacterType : std::uint8_t {
+    LIV = 0,
+    PIG = 1,
+    PIG_WITH_MATCHES = 2,
+    CANNON = 3,
+    CANNONBALL = 4,
+    KEY = 5,
+    COUNT
+};
+
+// Collision layer bits. Two characters only collide if each one's mask contains the other one's layer.
+namespace collision_layer {
+    auto constexpr NONE = std::uint32_t(0);
+    auto constexpr PLAYER = std::uint32_t(1) << 0;
+    auto constexpr ENEMY = std::uint32_t(1) << 1;
+    auto constexpr PROJECTILE = std::uint32_t(1) << 2;
+    auto constexpr ITEM = std::uint32_t(1) << 3;
+}
+
 #endif
@@ -0,0 +1,192 @@
+#include <collision/queries.hpp>
+#include <collision/CollisionProxies.hpp>
+#include <collision/StaticColliders.hpp>
+#include <constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+// Width of the buckets of the static collider index, walked by the raycasts
+auto constexpr BUCKET_WIDTH = double(TILE_SIZE * RegionIndex<StaticCollider>::BUCKET_COLUMNS);
+
+inline int cell_of(double coordinate)
+{
+    return int(std::floor(coordinate / TILE_SIZE));
+}
+
+inline bool stops_query(CollisionType type, TileQueryFilter filter)
+{
+    if (filter == TileQueryFilter::COLLIDEABLE) {
+        return type != CollisionType::NO_COLLISION;
+    }
+    return type == CollisionType::TILEMAP_COLLISION || type == CollisionType::DANGEROUS_COLLISION;
+}
+
+// Slab test: distance along the (normalized) ray at which it enters the region, if it does within `max_distance`,
+// and whether it enters through a left or right edge. A ray starting inside enters at 0, through the edges facing its
+// main axis. Rays merely touching the region (along an edge, or leaving it from an edge) don't enter it.
+std::optional<std::pair<double, bool>> ray_entry(Vector2D<double> const& origin, double dx, double dy,
+    Region2D<double> const& region, double max_distance)
+{
+    auto enter = 0.0;
+    auto exit = max_distance;
+    auto through_side_edge = std::abs(dx) >= std::abs(dy);
+    auto const clip = [&](double o, double d, double begin, double size, bool side_edges) {
+        if (d == 0.0) {
+            return o > begin && o < begin + size;
+        }
+        auto t0 = (begin - o) / d;
+        auto t1 = (begin + size - o) / d;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        if (t0 > enter) {
+            enter = t0;
+            through_side_edge = side_edges;
+        }
+        exit = std::min(exit, t1);
+        return enter < exit || (enter == exit && enter == max_distance);
+    };
+    if (clip(origin.x, dx, region.x, region.w, true) && clip(origin.y, dy, region.y, region.h, false)) {
+        return std::make_pair(enter, through_side_edge);
+    }
+    return std::nullopt;
+}
+
+// Tile of the region at the given point of its boundary
+Vector2D<int> tile_at(Region2D<double> const& region, Vector2D<double> const& point)
+{
+    auto const column = std::clamp(cell_of(point.x), cell_of(region.x), int(std::ceil((region.x + region.w) / TILE_SIZE)) - 1);
+    auto const row = std::clamp(cell_of(point.y), cell_of(region.y), int(std::ceil((region.y + region.h) / TILE_SIZE)) - 1);
+    return { column, row };
+}
+
+// Range of proxies (sorted by x) that may overlap the horizontal interval [left, right]
+std::pair<std::size_t, std::size_t> proxies_between(CollisionProxies const& proxies, double left, double right)
+{
+    auto const first = std::lower_bound(proxies.x.begin(), proxies.x.end(), left - proxies.max_width);
+    auto const last = std::upper_bound(first, proxies.x.end(), right);
+    return { std::size_t(first - proxies.x.begin()), std::size_t(last - proxies.x.begin()) };
+}
+} // namespace
+
+std::optional<TileHit> raycast_tiles(StaticColliders const& colliders, Vector2D<double> const& origin,
+    Vector2D<double> const& direction, double max_distance, TileQueryFilter filter)
+{
+    auto const length = std::hypot(direction.x, direction.y);
+    if (length == 0.0) {
+        return std::nullopt;
+    }
+    auto const dx = direction.x / length;
+    auto const dy = direction.y / length;
+    // Characters cast from the job system's threads
+    thread_local auto hits = std::vector<std::uint32_t>();
+
+    auto best = std::optional<TileHit>();
+    auto bucket = int(std::floor(origin.x / BUCKET_WIDTH));
+    auto from = 0.0;
+    while (true) {
+        // Part of the ray in the current column of buckets
+        auto to = max_distance;
+        if (dx != 0.0) {
+            auto const edge = BUCKET_WIDTH * (dx > 0 ? bucket + 1 : bucket);
+            to = std::clamp((edge - origin.x) / dx, from, max_distance);
+        }
+        auto const x0 = origin.x + dx * from;
+        auto const x1 = origin.x + dx * to;
+        auto const y0 = origin.y + dy * from;
+        auto const y1 = origin.y + dy * to;
+        // Widened by a pixel, as the index leaves out the colliders merely touching the queried region
+        hits.clear();
+        colliders.query({ std::min(x0, x1) - 1.0, std::min(y0, y1) - 1.0, std::abs(x1 - x0) + 2.0, std::abs(y1 - y0) + 2.0 },
+            hits);
+
+        for (auto index : hits) {
+            auto const& collider = colliders[index];
+            if (!stops_query(collider.collision_type, filter)) {
+                continue;
+            }
+            auto const entry = ray_entry(origin, dx, dy, collider.region, best ? best->distance : max_distance);
+            if (!entry || (best && entry->first >= best->distance)) {
+                continue;
+            }
+            auto const [distance, through_side_edge] = *entry;
+            auto const side = through_side_edge
+                ? (dx > 0 ? CollisionSide::RIGHT_COLLISION : CollisionSide::LEFT_COLLISION)
+                : (dy > 0 ? CollisionSide::TOP_COLLISION : CollisionSide::BOTTOM_COLLISION);
+            auto const point = Vector2D<double> { origin.x + dx * distance, origin.y + dy * distance };
+            best = TileHit { tile_at(collider.region, point), collider.collision_type, side, distance, point };
+        }
+
+        // Anything in the next buckets is farther
+        if ((best && best->distance <= to) || to >= max_distance) {
+            return best;
+        }
+        bucket += dx > 0 ? +1 : -1;
+        from = to;
+    }
+}
+
+std::optional<TileHit> segment_cast_tiles(StaticColliders const& colliders, Vector2D<double> const& from,
+    Vector2D<double> const& to, TileQueryFilter filter)
+{
+    auto const direction = to - from;
+    return raycast_tiles(colliders, from, direction, std::hypot(direction.x, direction.y), filter);
+}
+
+std::optional<TileHit> first_tile_below(StaticColliders const& colliders, Vector2D<double> const& position,
+    double max_distance, TileQueryFilter filter)
+{
+    return raycast_tiles(colliders, position, { 0.0, -1.0 }, max_distance, filter);
+}
+
+bool overlaps_tiles(StaticColliders const& colliders, Region2D<double> const& region, TileQueryFilter filter)
+{
+    thread_local auto hits = std::vector<std::uint32_t>();
+    hits.clear();
+    colliders.query(region, hits);
+    return std::any_of(hits.begin(), hits.end(), [&](auto index) {
+        return stops_query(colliders[index].collision_type, filter);
+    });
+}
+
+void overlap_characters(CollisionProxies const& proxies, Region2D<double> const& region, std::uint32_t layer_mask,
+    std::vector<IGameCharacter*>& hits)
+{
+    thread_local auto indices = std::vector<std::uint32_t>();
+    indices.clear();
+    auto const [first, last] = proxies_between(proxies, region.x, region.x + region.w);
+    proxies.overlapping(region, first, last, indices);
+    for (auto i : indices) {
+        if (proxies.layer[i] & layer_mask) {
+            hits.push_back(proxies.characters[i]);
+        }
+    }
+}
+
+std::optional<CharacterHit> raycast_characters(CollisionProxies const& proxies, Vector2D<double> const& origin,
+    Vector2D<double> const& direction, double max_distance, std::uint32_t layer_mask, IGameCharacter const* ignored)
+{
+    auto const length = std::hypot(direction.x, direction.y);
+    if (length == 0.0) {
+        return std::nullopt;
+    }
+    auto const dx = direction.x / length;
+    auto const dy = direction.y / length;
+    auto const end_x = origin.x + dx * max_distance;
+    auto const [first, last] = proxies_between(proxies, std::min(origin.x, end_x), std::max(origin.x, end_x));
+
+    auto best = std::optional<CharacterHit>();
+    for (auto i = first; i < last; ++i) {
+        if (!(proxies.layer[i] & layer_mask) || proxies.characters[i] == ignored) {
+            continue;
+        }
+        auto const entry = ray_entry(origin, dx, dy, proxies.region(i), best ? best->distance : max_distance);
+        if (entry && (!best || entry->first < best->distance)) {
+            auto const distance = entry->first;
+            best = CharacterHit { proxies.characters[i], distance, { origin.x + dx * distance, origin.y + dy * distance } };
+        }
+    }
+    return best;
+}
@@ -0,0 +1,73 @@
+#ifndef __COLLISION_QUERIES_HPP
+#define __COLLISION_QUERIES_HPP
+
+#include <Vector2D.hpp>
+#include <collision/enums.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Spatial queries for gameplay code (AI, line of sight, ledge detection...), against the static colliders of a level
+// (its merged tiles) and the character collision proxies. All positions are world positions; tiles are (column, row)
+// with rows counted from the bottom of the map, as in world coordinates. Everything out of the map is solid.
+//
+// The queries only read their inputs, and keep their scratch buffers per thread, so characters can run them from
+// the job system's threads.
+
+class StaticColliders;
+class CollisionProxies;
+class IGameCharacter;
+
+// Tiles that stop a query
+enum class TileQueryFilter {
+    // Solid and dangerous tiles
+    SOLID = 0,
+    // Any tile with a collision, one-way platforms included
+    COLLIDEABLE = 1
+};
+
+struct TileHit {
+    // Tile of the hit collider at the hit point
+    Vector2D<int> tile;
+    CollisionType collision_type;
+    // Side of the ray that touched the tile, as reported to IGameCharacter::handle_collision
+    CollisionSide side;
+    double distance;
+    Vector2D<double> point;
+};
+
+struct CharacterHit {
+    IGameCharacter* character;
+    double distance;
+    Vector2D<double> point;
+};
+
+// First tile hit by the ray, up to `max_distance`. The ray walks the columns of buckets of the static collider
+// index it crosses (a grid DDA), and slab tests the colliders of each one. The direction doesn't need to be
+// normalized. A ray starting inside a tile hits it at distance 0.
+std::optional<TileHit> raycast_tiles(StaticColliders const& colliders, Vector2D<double> const& origin,
+    Vector2D<double> const& direction, double max_distance, TileQueryFilter filter = TileQueryFilter::SOLID);
+
+// Raycast from `from` to `to`, e.g. "can this pig see the player?"
+std::optional<TileHit> segment_cast_tiles(StaticColliders const& colliders, Vector2D<double> const& from,
+    Vector2D<double> const& to, TileQueryFilter filter = TileQueryFilter::SOLID);
+
+// First tile straight below the position, e.g. "is there ground ahead?"
+std::optional<TileHit> first_tile_below(StaticColliders const& colliders, Vector2D<double> const& position,
+    double max_distance, TileQueryFilter filter = TileQueryFilter::COLLIDEABLE);
+
+// Whether the region overlaps any tile. Tiles merely touching the region don't count.
+bool overlaps_tiles(StaticColliders const& colliders, Region2D<double> const& region,
+    TileQueryFilter filter = TileQueryFilter::SOLID);
+
+// Appends to `hits` the characters whose collision region overlaps the region, and whose collision layer is in
+// `layer_mask`
+void overlap_characters(CollisionProxies const& proxies, Region2D<double> const& region, std::uint32_t layer_mask,
+    std::vector<IGameCharacter*>& hits);
+
+// Closest character hit by the ray, among the ones whose collision layer is in `layer_mask` (but `ignored`)
+std::optional<CharacterHit> raycast_characters(CollisionProxies const& proxies, Vector2D<double> const& origin,
+    Vector2D<double> const& direction, double max_distance, std::uint32_t layer_mask,
+    IGameCharacter const* ignored = nullptr);
+
+#endif
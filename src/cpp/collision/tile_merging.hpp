@@ -0,0 +1,59 @@
+#ifndef __TILE_MERGING_HPP
+#define __TILE_MERGING_HPP
+
+#include <cstdint>
+#include <vector>
+
+// Greedily merges the tiles of a width x height grid that have the same key into maximal rectangles, column by
+// column (so that streamed tilemaps are read one chunk at a time, see TilemapReader). Each tile that isn't merged yet starts a
+// rectangle, which grows upwards as far as possible, and then to the right for as long as the whole next column
+// matches. Tiles with key 0 are left out.
+//
+// `key(row, column)` returns the key of a tile; `on_rectangle(column, row, columns, rows, key)` is called for each
+// rectangle. Rows are counted from the bottom, as in world coordinates.
+template <typename KeyFunction, typename RectangleFunction>
+void merge_tiles(int width, int height, KeyFunction const& key, RectangleFunction const& on_rectangle)
+{
+    auto merged = std::vector<bool>(std::size_t(width) * height);
+    auto const is_merged = [&](int row, int column) {
+        return merged[std::size_t(column) * height + row];
+    };
+
+    for (int column = 0; column < width; ++column) {
+        for (int row = 0; row < height; ++row) {
+            if (is_merged(row, column)) {
+                continue;
+            }
+            auto const rectangle_key = std::uint32_t(key(row, column));
+            if (rectangle_key == 0) {
+                continue;
+            }
+
+            auto top = row + 1;
+            while (top < height && !is_merged(top, column) && std::uint32_t(key(top, column)) == rectangle_key) {
+                ++top;
+            }
+            auto const column_matches = [&](int next_column) {
+                for (int r = row; r < top; ++r) {
+                    if (is_merged(r, next_column) || std::uint32_t(key(r, next_column)) != rectangle_key) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            auto right = column + 1;
+            while (right < width && column_matches(right)) {
+                ++right;
+            }
+
+            for (int c = column; c < right; ++c) {
+                for (int r = row; r < top; ++r) {
+                    merged[std::size_t(c) * height + r] = true;
+                }
+            }
+            on_rectangle(column, row, right - column, top - row, rectangle_key);
+        }
+    }
+}
+
+#endif
@@ -1,179 +1,134 @@
-#include <GameMap.hpp>
 #include <characters/IGameCharacter.hpp>
 #include <cmath>
-#include <collision/aabb.hpp>
+#include <collision/StaticColliders.hpp>
 #include <collision/enums.hpp>
 #include <collision/tilemap_collision.hpp>
-#include <constants.hpp>
-#include <functional>
-#include <levels/IGameLevel.hpp>
-#include <stdexcept>
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
 
-namespace {
-struct TileCollisionInformation {
-    Region2D<double> tile_region;
-    bool is_collideable;
-    CollisionType collision_type;
-    std::function<void()> collision_callback;
-};
+// The character's movement in the last frame (from its old to its current collision region) is swept against the
+// level's static colliders (the merged tiles of its map), one axis at a time: first horizontally at the old height,
+// then vertically at the resolved horizontal position. Only the colliders whose near edge is crossed by the box are
+// considered, so fast movers can't tunnel through walls.
 
-using TileId = int;
-static auto const TILE_COLLISION_TYPE = std::unordered_map<TileId, CollisionType>{
-    {13, CollisionType::DANGEROUS_COLLISION},
-    {16, CollisionType::BOTTOM_ONLY_COLLISION},
-    {17, CollisionType::BOTTOM_ONLY_COLLISION},
-    {18, CollisionType::BOTTOM_ONLY_COLLISION},
-    {19, CollisionType::BOTTOM_ONLY_COLLISION}
-};
+namespace {
+// Colliders crossed by a sweep, with the position of their near edge along the swept axis
+using CrossedColliders = std::vector<std::pair<double, std::uint32_t>>;
 
-TileCollisionInformation tile_info_from_position(GameMap const& map, Vector2D<double> const& position,
-    IGameLevel& level, IGameCharacter* character)
+inline bool is_solid(CollisionType type)
 {
-    int j = std::floor(position.x / TILE_SIZE);
-    int i = std::floor(position.y / TILE_SIZE);
-
-    auto tile_world_position = Vector2D<int> { TILE_SIZE * j, TILE_SIZE * i };
-    auto tile_region = Region2D<double> { double(tile_world_position.x), double(tile_world_position.y), double(TILE_SIZE),
-        double(TILE_SIZE) };
-
-    if (i < 0 || i > map.height || j < 0 || j > map.width) {
-        return { tile_region, true, CollisionType::TILEMAP_COLLISION };
-    }
-
-    auto is_collideable = false;
-    auto collision_type = CollisionType::NO_COLLISION;
-    auto collision_callback = std::function<void()>();
-
-    auto tile_id = map.tilemap[map.height - i - 1][j];
-    if (tile_id != 0) {
-        is_collideable = true;
-        try {
-            collision_type = TILE_COLLISION_TYPE.at(tile_id);
-        } catch (std::out_of_range const& _) {
-            collision_type = CollisionType::TILEMAP_COLLISION;
-        }
-    }
-
-    return { tile_region, is_collideable, collision_type, collision_callback };
+    return type == CollisionType::TILEMAP_COLLISION || type == CollisionType::DANGEROUS_COLLISION;
 }
 
-void compute_single_collission(TileCollisionInformation const& info, IGameCharacter* character)
+// Resolves a sweep along one axis, given the colliders crossed by the leading edge of the box, in the order they're
+// reached. Any collider stops the box if `any_blocks`, otherwise only solid
+// ones do. Every collider reached (up to the blocking one) is reported to the character. Returns the near edge of
+// the blocking collider, if any.
+std::optional<double> resolve_sweep(StaticColliders const& colliders, CrossedColliders const& crossed, bool any_blocks,
+    IGameCharacter* character, CollisionSide side)
 {
-    auto const& tile_region = info.tile_region;
-    auto const& collision_type = info.collision_type;
-
-    auto collision_region_info = character->get_collision_region_information();
-    auto const& collision_region = collision_region_info.collision_region;
-    auto const& old_collision_region = collision_region_info.old_collision_region;
-    auto const& current_position = character->get_position();
-    auto const& current_velocity = character->get_velocity();
-
-    if (check_aabb_collision(collision_region, tile_region)) {
-        if (info.collision_callback) {
-            info.collision_callback();
+    auto blocking_edge = std::optional<double>();
+    for (auto const& [near_edge, index] : crossed) {
+        if (blocking_edge && near_edge != *blocking_edge) {
+            break;
         }
-
-        if (collision_region.x + collision_region.w > tile_region.x && old_collision_region.x + old_collision_region.w <= tile_region.x) {
-            if (collision_type == CollisionType::TILEMAP_COLLISION || collision_type == CollisionType::DANGEROUS_COLLISION) {
-                character->set_position(tile_region.x - collision_region.w - 0.1, current_position.y);
-                character->set_velocity(0.0, current_velocity.y);
-            }
-            character->handle_collision(collision_type, CollisionSide::RIGHT_COLLISION);
-        } else if (collision_region.x < tile_region.x + tile_region.w && old_collision_region.x >= tile_region.x + tile_region.w) {
-            if (collision_type == CollisionType::TILEMAP_COLLISION || collision_type == CollisionType::DANGEROUS_COLLISION) {
-                character->set_position(tile_region.x + tile_region.w + 0.1, current_position.y);
-                character->set_velocity(0.0, current_velocity.y);
-            }
-            character->handle_collision(collision_type, CollisionSide::LEFT_COLLISION);
-        } else if (collision_region.y < tile_region.y + tile_region.h && old_collision_region.y >= tile_region.y + tile_region.h) {
-            character->set_position(current_position.x, tile_region.y + tile_region.h + 0.25);
-            character->set_velocity(current_velocity.x, 0.0);
-            character->handle_collision(collision_type, CollisionSide::BOTTOM_COLLISION);
-        } else if (collision_region.y + collision_region.h > tile_region.y && old_collision_region.y + old_collision_region.h <= tile_region.y) {
-            if (collision_type == CollisionType::TILEMAP_COLLISION || collision_type == CollisionType::DANGEROUS_COLLISION) {
-                character->set_position(current_position.x, tile_region.y - collision_region.h - 0.1);
-                character->set_velocity(current_velocity.x, 0.0);
-            }
-            character->handle_collision(collision_type, CollisionSide::TOP_COLLISION);
+        auto const collision_type = colliders[index].collision_type;
+        if (collision_type == CollisionType::NO_COLLISION) {
+            continue;
+        }
+        if ((any_blocks || is_solid(collision_type)) && !blocking_edge) {
+            blocking_edge = near_edge;
         }
+        character->handle_collision(collision_type, side);
     }
+    return blocking_edge;
 }
-} // namespace
 
-void compute_tilemap_collisions(GameMap const& map, IGameCharacter* character, IGameLevel& level)
+// Colliders overlapping the swept region whose near edge is crossed by the leading edge of the box, moving from
+// `from` to `to`, sorted by distance. The characters are resolved in parallel, hence the per thread buffers.
+CrossedColliders const& crossed_colliders(StaticColliders const& colliders,
+    Region2D<double> const& swept_region, double from, double to, bool horizontal)
 {
-    auto collision_region_info = character->get_collision_region_information();
-    auto const& collision_region = collision_region_info.collision_region;
-    auto const& old_collision_region = collision_region_info.old_collision_region;
-
-    // Left-bottom
-    {
-        auto tile_collision_info = tile_info_from_position(map, { collision_region.x, collision_region.y }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
+    thread_local auto hits = std::vector<std::uint32_t>();
+    thread_local auto crossed = CrossedColliders();
+    hits.clear();
+    crossed.clear();
+    colliders.query(swept_region, hits);
+
+    auto const forward = to > from;
+    for (auto index : hits) {
+        auto const& region = colliders[index].region;
+        auto const begin = horizontal ? region.x : region.y;
+        auto const end = begin + (horizontal ? region.w : region.h);
+        auto const near_edge = forward ? begin : end;
+        if (forward ? near_edge >= from : near_edge <= from) {
+            crossed.push_back({ near_edge, index });
         }
     }
+    std::sort(crossed.begin(), crossed.end(), [forward](auto const& a, auto const& b) {
+        return forward ? a.first < b.first : a.first > b.first;
+    });
+    return crossed;
+}
 
-    // Middle-bottom
-    {
-        auto tile_collision_info = tile_info_from_position(map, { collision_region.x + collision_region.w / 2, collision_region.y }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
+// Sweeps the box horizontally, from `from_x` to `box.x`, and stops it at the first solid collider
+void sweep_horizontally(StaticColliders const& colliders, IGameCharacter* character, Region2D<double>& box, double from_x)
+{
+    if (box.x == from_x) {
+        return;
     }
-
-    // Right-bottom
-    {
-        auto tile_collision_info = tile_info_from_position(
-            map, { collision_region.x + collision_region.w, collision_region.y }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
+    auto const moving_right = box.x > from_x;
+    auto const leading_edge = moving_right ? box.w : 0.0;
+    auto const from = from_x + leading_edge;
+    auto const to = box.x + leading_edge;
+    auto const swept_region = Region2D<double> { std::min(from, to), box.y, std::abs(to - from), box.h };
+    auto const& crossed = crossed_colliders(colliders, swept_region, from, to, true);
+
+    auto side = moving_right ? CollisionSide::RIGHT_COLLISION : CollisionSide::LEFT_COLLISION;
+    if (auto edge = resolve_sweep(colliders, crossed, false, character, side)) {
+        box.x = moving_right ? *edge - box.w - 0.1 : *edge + 0.1;
+        character->set_position(box.x, character->get_position().y);
+        character->set_velocity(0.0, character->get_velocity().y);
     }
+}
 
-    // Left-middle
-    {
-        auto tile_collision_info = tile_info_from_position(
-                map, { collision_region.x, collision_region.y + collision_region.h / 2 }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
+// Sweeps the box vertically, from `from_y` to `box.y`. Any collider stops a falling box (one-way platforms
+// included), but only solid ones stop a rising one.
+void sweep_vertically(StaticColliders const& colliders, IGameCharacter* character, Region2D<double>& box, double from_y)
+{
+    if (box.y == from_y) {
+        return;
     }
-
-    // Right-middle
-    {
-        auto tile_collision_info = tile_info_from_position(
-                map, { collision_region.x + collision_region.w, collision_region.y + collision_region.h / 2 }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
+    auto const moving_up = box.y > from_y;
+    auto const leading_edge = moving_up ? box.h : 0.0;
+    auto const from = from_y + leading_edge;
+    auto const to = box.y + leading_edge;
+    auto const swept_region = Region2D<double> { box.x, std::min(from, to), box.w, std::abs(to - from) };
+    auto const& crossed = crossed_colliders(colliders, swept_region, from, to, false);
+
+    auto side = moving_up ? CollisionSide::TOP_COLLISION : CollisionSide::BOTTOM_COLLISION;
+    if (auto edge = resolve_sweep(colliders, crossed, !moving_up, character, side)) {
+        box.y = moving_up ? *edge - box.h - 0.1 : *edge + 0.25;
+        character->set_position(character->get_position().x, box.y);
+        character->set_velocity(character->get_velocity().x, 0.0);
     }
+}
 
-    // Left-top
-    {
-        auto tile_collision_info = tile_info_from_position(
-                map, { collision_region.x, collision_region.y + collision_region.h }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
-    }
+} // namespace
 
-    // Middle-top
-    {
-        auto tile_collision_info = tile_info_from_position(map, { collision_region.x + collision_region.w / 2, collision_region.y + collision_region.h }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
-    }
+void compute_tilemap_collisions(StaticColliders const& colliders, IGameCharacter* character)
+{
+    auto collision_region_info = character->get_collision_region_information();
+    auto const& old_collision_region = collision_region_info.old_collision_region;
 
-    // Right-top
-    {
-        auto tile_collision_info = tile_info_from_position(
-                map, { collision_region.x + collision_region.w, collision_region.y + collision_region.h }, level, character);
-        if (tile_collision_info.is_collideable) {
-            compute_single_collission(tile_collision_info, character);
-        }
-    }
+    auto box = collision_region_info.collision_region;
+    auto const target_y = box.y;
+    box.y = old_collision_region.y;
+    sweep_horizontally(colliders, character, box, old_collision_region.x);
+    box.y = target_y;
+    sweep_vertically(colliders, character, box, old_collision_region.y);
 
     character->on_after_collision();
 }
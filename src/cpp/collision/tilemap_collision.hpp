@@ -1,10 +1,9 @@
 #ifndef __TILEMAP_COLLISION_HPP
 #define __TILEMAP_COLLISION_HPP
 
-class IGameLevel;
-class GameMap;
+class StaticColliders;
 class IGameCharacter;
 
-void compute_tilemap_collisions(GameMap const& map, IGameCharacter* c, IGameLevel& level);
+void compute_tilemap_collisions(StaticColliders const& colliders, IGameCharacter* c);
 
 #endif
@@ -5,12 +5,28 @@
 #define FORCE_SCALE_SIZE 2
 #endif
 
+// Frames per second, 0 follows the display refresh rate
+#ifndef FORCE_FRAME_RATE
+#define FORCE_FRAME_RATE 0
+#endif
+
+#ifndef FORCE_VSYNC
+#define FORCE_VSYNC 0
+#endif
+
 auto constexpr WINDOW_TITLE = "Pigs Castle";
 auto constexpr SCALE_SIZE = FORCE_SCALE_SIZE;
 auto constexpr TILE_SIZE = 16;
 auto constexpr SCREEN_WIDTH = 600 * SCALE_SIZE;
 auto constexpr SCREEN_HEIGHT = 300 * SCALE_SIZE;
+auto constexpr TARGET_FRAME_RATE = FORCE_FRAME_RATE;
+auto constexpr ENABLE_VSYNC = FORCE_VSYNC != 0;
 
 auto constexpr gravity = -0.001;
 
+// The simulation runs at a fixed rate (in milliseconds per tick), independently of the rendering frame rate. A slow
+// frame runs at most MAX_TICKS_PER_FRAME ticks to catch up, the rest of the lag is dropped.
+auto constexpr TICK_DURATION = 1000.0 / 120.0;
+auto constexpr MAX_TICKS_PER_FRAME = 8;
+
 #endif
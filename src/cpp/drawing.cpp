@@ -1,5 +1,9 @@
 #include <drawing.hpp>
+#include <TilemapChunkCache.hpp>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <utility>
 
 Vector2D<int> to_world_position(Vector2D<int> const& camera_position, Vector2D<int> const& size,
     Vector2D<int> const& camera_offset)
@@ -15,47 +19,252 @@ Vector2D<int> to_camera_position(Vector2D<int> const& world_position, Vector2D<i
         SCALE_SIZE * ((world_position.y + size.y - camera_offset.y) / -1) + SCREEN_HEIGHT };
 }
 
-void draw_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+SpriteBatch::SpriteBatch()
+    : renderer(nullptr)
+    , batches()
+    , active_batches(0)
+{
+}
+
+void SpriteBatch::add(SDL_Renderer* renderer, SDL_Texture* texture, SDL_Rect const& srcrect, SDL_Rect const& dstrect,
+    SDL_RendererFlip const& flip, SDL_Color const& color)
+{
+    auto& batch = this->batch_for(renderer, texture);
+    auto uv_min = SDL_FPoint { srcrect.x * batch.inverse_width, srcrect.y * batch.inverse_height };
+    auto uv_max = SDL_FPoint { (srcrect.x + srcrect.w) * batch.inverse_width, (srcrect.y + srcrect.h) * batch.inverse_height };
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        std::swap(uv_min.x, uv_max.x);
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        std::swap(uv_min.y, uv_max.y);
+    }
+    SpriteBatch::push_quad(batch, dstrect, uv_min, uv_max, color);
+}
+
+void SpriteBatch::add_filled(SDL_Renderer* renderer, SDL_Rect const& dstrect, SDL_Color const& color)
+{
+    auto& batch = this->batch_for(renderer, nullptr);
+    SpriteBatch::push_quad(batch, dstrect, { 0.f, 0.f }, { 0.f, 0.f }, color);
+}
+
+void SpriteBatch::flush()
+{
+    for (std::size_t i = 0; i < this->active_batches; ++i) {
+        auto& batch = this->batches[i];
+        if (!batch.indices.empty()) {
+            SDL_RenderGeometry(this->renderer, batch.texture, batch.vertices.data(), int(batch.vertices.size()),
+                batch.indices.data(), int(batch.indices.size()));
+        }
+        // Keep the buffers' capacity, so that the next frames don't allocate
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+    this->active_batches = 0;
+}
+
+SpriteBatch::TextureBatch& SpriteBatch::batch_for(SDL_Renderer* renderer, SDL_Texture* texture)
+{
+    if (renderer != this->renderer) {
+        this->flush();
+        this->renderer = renderer;
+    }
+
+    // Consecutive quads sharing a texture go in the same batch; any texture change starts a new one, so that the
+    // quads are drawn in the order they were added
+    if (this->active_batches > 0 && this->batches[this->active_batches - 1].texture == texture) {
+        return this->batches[this->active_batches - 1];
+    }
+
+    if (this->active_batches == this->batches.size()) {
+        this->batches.emplace_back();
+    }
+    auto& batch = this->batches[this->active_batches++];
+    batch.texture = texture;
+    batch.inverse_width = 0.f;
+    batch.inverse_height = 0.f;
+    if (texture != nullptr) {
+        int w = 0;
+        int h = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        batch.inverse_width = (w > 0) ? 1.f / float(w) : 0.f;
+        batch.inverse_height = (h > 0) ? 1.f / float(h) : 0.f;
+    }
+    return batch;
+}
+
+void SpriteBatch::push_quad(TextureBatch& batch, SDL_Rect const& dstrect, SDL_FPoint const& uv_min,
+    SDL_FPoint const& uv_max, SDL_Color const& color)
+{
+    auto x0 = float(dstrect.x);
+    auto y0 = float(dstrect.y);
+    auto x1 = float(dstrect.x + dstrect.w);
+    auto y1 = float(dstrect.y + dstrect.h);
+
+    auto first = int(batch.vertices.size());
+    batch.vertices.push_back({ { x0, y0 }, color, { uv_min.x, uv_min.y } });
+    batch.vertices.push_back({ { x1, y0 }, color, { uv_max.x, uv_min.y } });
+    batch.vertices.push_back({ { x1, y1 }, color, { uv_max.x, uv_max.y } });
+    batch.vertices.push_back({ { x0, y1 }, color, { uv_min.x, uv_max.y } });
+    for (auto const& index : { 0, 1, 2, 0, 2, 3 }) {
+        batch.indices.push_back(first + index);
+    }
+}
+
+SpriteBatch sprite_batch;
+
+DrawList::DrawList()
+    : commands()
+    , tilemaps()
+{
+}
+
+void DrawList::clear_screen(RGBColor const& color)
+{
+    auto sdl_color = SDL_Color { Uint8(color.r), Uint8(color.g), Uint8(color.b), 255 };
+    this->commands.push_back({ CommandType::CLEAR_SCREEN, nullptr, {}, {}, SDL_FLIP_NONE, sdl_color, 0 });
+}
+
+void DrawList::add(SDL_Texture* texture, SDL_Rect const& srcrect, SDL_Rect const& dstrect, SDL_RendererFlip const& flip,
+    SDL_Color const& color)
+{
+    this->commands.push_back({ CommandType::QUAD, texture, srcrect, dstrect, flip, color, 0 });
+}
+
+void DrawList::add_filled(SDL_Rect const& dstrect, SDL_Color const& color)
+{
+    this->commands.push_back({ CommandType::FILLED_QUAD, nullptr, {}, dstrect, SDL_FLIP_NONE, color, 0 });
+}
+
+void DrawList::add_line(Vector2D<int> const& start_position, Vector2D<int> const& end_position, SDL_Color const& color)
+{
+    auto line = SDL_Rect { start_position.x, start_position.y, end_position.x, end_position.y };
+    this->commands.push_back({ CommandType::LINE, nullptr, {}, line, SDL_FLIP_NONE, color, 0 });
+}
+
+void DrawList::add_tilemap(TilemapChunkCache& tilemap_cache, Region2D<int> const& visible_tiles,
+    Vector2D<int> const& camera_offset, Vector2D<int> const& shake)
+{
+    this->commands.push_back({ CommandType::TILEMAP, nullptr, {}, {}, SDL_FLIP_NONE, {}, this->tilemaps.size() });
+    this->tilemaps.push_back({ &tilemap_cache, visible_tiles, camera_offset, shake });
+}
+
+void DrawList::flush()
+{
+    this->commands.push_back({ CommandType::FLUSH, nullptr, {}, {}, SDL_FLIP_NONE, {}, 0 });
+}
+
+void DrawList::submit(SDL_Renderer* renderer) const
+{
+    for (auto const& command : this->commands) {
+        switch (command.type) {
+        case CommandType::QUAD:
+            sprite_batch.add(renderer, command.texture, command.srcrect, command.dstrect, command.flip, command.color);
+            break;
+        case CommandType::FILLED_QUAD:
+            sprite_batch.add_filled(renderer, command.dstrect, command.color);
+            break;
+        case CommandType::LINE:
+            sprite_batch.flush();
+            SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            SDL_RenderDrawLine(renderer, command.dstrect.x, command.dstrect.y, command.dstrect.w, command.dstrect.h);
+            break;
+        case CommandType::CLEAR_SCREEN:
+            sprite_batch.flush();
+            SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+            SDL_RenderClear(renderer);
+            break;
+        case CommandType::TILEMAP: {
+            auto const& tilemap = this->tilemaps[command.index];
+            tilemap.tilemap_cache->draw(renderer, tilemap.visible_tiles, tilemap.camera_offset, tilemap.shake);
+            break;
+        }
+        case CommandType::FLUSH:
+            sprite_batch.flush();
+            break;
+        }
+    }
+    sprite_batch.flush();
+}
+
+void DrawList::invalidate_tilemaps() const
+{
+    for (auto const& tilemap : this->tilemaps) {
+        tilemap.tilemap_cache->invalidate_all();
+    }
+}
+
+void DrawList::reset()
+{
+    this->commands.clear();
+    this->tilemaps.clear();
+}
+
+Region2D<int> visible_tiles_region(Vector2D<int> const& camera_offset, int map_width, int map_height,
+    Vector2D<int> const& window_size)
+{
+    // World region covered by the window (see to_camera_position: the window bottom is anchored at SCREEN_HEIGHT)
+    auto view_min = Vector2D<int> { camera_offset.x, camera_offset.y + (SCREEN_HEIGHT - window_size.y) / SCALE_SIZE };
+    auto view_max = Vector2D<int> { camera_offset.x + window_size.x / SCALE_SIZE, camera_offset.y + SCREEN_HEIGHT / SCALE_SIZE };
+
+    // Keep one extra tile on each side, so that partially visible tiles and the window shake are covered
+    auto first_col = std::max(0, int(std::floor(double(view_min.x) / TILE_SIZE)) - 1);
+    auto last_col = std::min(map_width, int(std::floor(double(view_max.x) / TILE_SIZE)) + 2);
+    auto first_world_row = std::max(0, int(std::floor(double(view_min.y) / TILE_SIZE)) - 1);
+    auto last_world_row = std::min(map_height, int(std::floor(double(view_max.y) / TILE_SIZE)) + 2);
+
+    // Tilemap rows grow downwards, while world rows grow upwards
+    auto first_row = map_height - last_world_row;
+    auto last_row = map_height - first_world_row;
+
+    return { first_col, first_row, std::max(0, last_col - first_col), std::max(0, last_row - first_row) };
+}
+
+void draw_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& world_position, Vector2D<int> const& size, Vector2D<int> const& camera_offset,
     SDL_RendererFlip const& flip)
 {
-    auto srcrect = SDL_Rect { sprite_offset.x, sprite_offset.y, size.x, size.y };
+    auto srcrect = SDL_Rect { spritesheet.origin.x + sprite_offset.x, spritesheet.origin.y + sprite_offset.y, size.x, size.y };
     auto camera_position = to_camera_position(world_position, size, camera_offset);
     auto dstrect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * size.x, SCALE_SIZE * size.y };
-    SDL_RenderCopyEx(renderer, spritesheet, &srcrect, &dstrect, 0.0, nullptr, flip);
+    draw_list.add(spritesheet.texture, srcrect, dstrect, flip);
 }
 
 // Rething about this. Perhaps solve in PIG-12
-void draw_static_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+void draw_static_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& static_camera_position, Vector2D<int> const& size,
     SDL_RendererFlip const& flip)
 {
-    auto srcrect = SDL_Rect { sprite_offset.x, sprite_offset.y, size.x, size.y };
+    auto srcrect = SDL_Rect { spritesheet.origin.x + sprite_offset.x, spritesheet.origin.y + sprite_offset.y, size.x, size.y };
     auto camera_position = to_camera_position(static_camera_position, size, { 0, 0 });
     auto dstrect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * size.x, SCALE_SIZE * size.y };
-    SDL_RenderCopyEx(renderer, spritesheet, &srcrect, &dstrect, 0.0, nullptr, flip);
+    draw_list.add(spritesheet.texture, srcrect, dstrect, flip);
 }
 
-void draw_direct_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+void draw_direct_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& sdlwindow_position, Vector2D<int> const& size)
 {
-    auto srcrect = SDL_Rect { sprite_offset.x, sprite_offset.y, size.x, size.y };
+    auto srcrect = SDL_Rect { spritesheet.origin.x + sprite_offset.x, spritesheet.origin.y + sprite_offset.y, size.x, size.y };
     auto dstrect = SDL_Rect { sdlwindow_position.x, sdlwindow_position.y, SCALE_SIZE * size.x, SCALE_SIZE * size.y };
-    SDL_RenderCopy(renderer, spritesheet, &srcrect, &dstrect);
+    draw_list.add(spritesheet.texture, srcrect, dstrect);
+}
+
+void draw_sprite_rect(DrawList& draw_list, SpriteSheet const& spritesheet, SDL_Rect const& srcrect,
+    SDL_Rect const& sdlwindow_rect)
+{
+    auto atlas_srcrect = SDL_Rect { spritesheet.origin.x + srcrect.x, spritesheet.origin.y + srcrect.y, srcrect.w, srcrect.h };
+    draw_list.add(spritesheet.texture, atlas_srcrect, sdlwindow_rect);
 }
 
-void draw_filled_region(SDL_Renderer* renderer, Region2D<int> const& region, RGBColor const& fill_color)
+void draw_filled_region(DrawList& draw_list, Region2D<int> const& region, RGBColor const& fill_color)
 {
-    SDL_SetRenderDrawColor(renderer, fill_color.r, fill_color.g, fill_color.b, 255);
-    auto rect = to_sdl_rect(region);
-    SDL_RenderFillRect(renderer, &rect);
+    auto color = SDL_Color { Uint8(fill_color.r), Uint8(fill_color.g), Uint8(fill_color.b), 255 };
+    draw_list.add_filled(to_sdl_rect(region), color);
 }
 
-void draw_line(SDL_Renderer* renderer, Vector2D<int> const& start_position, Vector2D<int> const& end_position,
+void draw_line(DrawList& draw_list, Vector2D<int> const& start_position, Vector2D<int> const& end_position,
     RGBColor const& fill_color)
 {
-    SDL_SetRenderDrawColor(renderer, fill_color.r, fill_color.g, fill_color.b, 255);
-    SDL_RenderDrawLine(renderer, start_position.x, start_position.y, end_position.x, end_position.y);
+    draw_list.add_line(start_position, end_position, SDL_Color { Uint8(fill_color.r), Uint8(fill_color.g), Uint8(fill_color.b), 255 });
 }
 
 int gstr_width(std::string const& text)
@@ -63,7 +272,7 @@ int gstr_width(std::string const& text)
     return text.size() * 6 * SCALE_SIZE;
 }
 
-Region2D<int> gout(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& static_camera_position,
+Region2D<int> gout(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& static_camera_position,
     std::string const& message, RGBColor const& text_color, bool scale)
 {
     auto scale_size = scale ? SCALE_SIZE : 1;
@@ -72,9 +281,9 @@ Region2D<int> gout(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<in
     auto size = Vector2D<int> { 6, 9 };
     auto srcrect = SDL_Rect { 0, 0, size.x, size.y };
     auto dstrect = SDL_Rect { static_camera_position.x, static_camera_position.y, size.x * scale_size, size.y * scale_size };
-    auto const& charmap = MonogramFont::charmap();
+    static auto const charmap = MonogramFont::charmap();
 
-    SDL_SetTextureColorMod(spritesheet, text_color.r, text_color.g, text_color.b);
+    auto color = SDL_Color { Uint8(text_color.r), Uint8(text_color.g), Uint8(text_color.b), 255 };
     for (auto const& c : message) {
         auto const& charmap_pos = [&]() {
             try {
@@ -83,9 +292,9 @@ Region2D<int> gout(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<in
                 return charmap.at('?');
             }
         }();
-        srcrect.x = size.x * charmap_pos.x;
-        srcrect.y = size.y * charmap_pos.y;
-        SDL_RenderCopy(renderer, spritesheet, &srcrect, &dstrect);
+        srcrect.x = spritesheet.origin.x + size.x * charmap_pos.x;
+        srcrect.y = spritesheet.origin.y + size.y * charmap_pos.y;
+        draw_list.add(spritesheet.texture, srcrect, dstrect, SDL_FLIP_NONE, color);
         dstrect.x += size.x * scale_size;
         gout_region.w += size.x * scale_size;
     }
@@ -8,7 +8,102 @@
 #include <Vector2D.hpp>
 #include <bitmap_font.hpp>
 #include <constants.hpp>
+#include <sdl_wrappers.hpp>
+#include <cstddef>
 #include <string>
+#include <vector>
+
+// Collects runs of consecutive quads sharing a texture (filled quads have none) and submits each run with a single
+// SDL_RenderGeometry call. Quads are drawn in the order they were added; sprites packed on the same atlas page batch
+// together until a quad with another texture (e.g. a filled one) comes in between.
+// Call flush() at layer boundaries and before any direct SDL drawing call (including SDL_RenderPresent).
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    void add(SDL_Renderer* renderer, SDL_Texture* texture, SDL_Rect const& srcrect, SDL_Rect const& dstrect,
+        SDL_RendererFlip const& flip = SDL_FLIP_NONE, SDL_Color const& color = { 255, 255, 255, 255 });
+    void add_filled(SDL_Renderer* renderer, SDL_Rect const& dstrect, SDL_Color const& color);
+    void flush();
+
+private:
+    struct TextureBatch {
+        SDL_Texture* texture;
+        float inverse_width;
+        float inverse_height;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    TextureBatch& batch_for(SDL_Renderer* renderer, SDL_Texture* texture);
+    static void push_quad(TextureBatch& batch, SDL_Rect const& dstrect, SDL_FPoint const& uv_min,
+        SDL_FPoint const& uv_max, SDL_Color const& color);
+
+private:
+    SDL_Renderer* renderer;
+    std::vector<TextureBatch> batches;
+    std::size_t active_batches;
+};
+
+extern SpriteBatch sprite_batch;
+
+class TilemapChunkCache;
+
+// Drawing commands recorded for a frame, submitted later through the sprite batch. A recorded list isn't modified by
+// submitting it, so it can be recorded on the simulation thread and submitted (even several times) on the render one.
+// It only refers to textures and tilemap caches, which must outlive it.
+class DrawList {
+public:
+    DrawList();
+
+    void clear_screen(RGBColor const& color);
+    void add(SDL_Texture* texture, SDL_Rect const& srcrect, SDL_Rect const& dstrect,
+        SDL_RendererFlip const& flip = SDL_FLIP_NONE, SDL_Color const& color = { 255, 255, 255, 255 });
+    void add_filled(SDL_Rect const& dstrect, SDL_Color const& color);
+    void add_line(Vector2D<int> const& start_position, Vector2D<int> const& end_position, SDL_Color const& color);
+    void add_tilemap(TilemapChunkCache& tilemap_cache, Region2D<int> const& visible_tiles,
+        Vector2D<int> const& camera_offset, Vector2D<int> const& shake);
+    // Layer boundary (see SpriteBatch::flush)
+    void flush();
+
+    void submit(SDL_Renderer* renderer) const;
+    // Re-bakes the recorded tilemaps when next submitted (see TilemapChunkCache::invalidate_all)
+    void invalidate_tilemaps() const;
+    // Removes every command, keeping the buffers' capacity
+    void reset();
+
+private:
+    enum class CommandType {
+        QUAD,
+        FILLED_QUAD,
+        LINE,
+        CLEAR_SCREEN,
+        TILEMAP,
+        FLUSH
+    };
+
+    // Lines go from (dstrect.x, dstrect.y) to (dstrect.w, dstrect.h). Tilemaps are drawn from tilemaps[index].
+    struct Command {
+        CommandType type;
+        SDL_Texture* texture;
+        SDL_Rect srcrect;
+        SDL_Rect dstrect;
+        SDL_RendererFlip flip;
+        SDL_Color color;
+        std::size_t index;
+    };
+
+    struct TilemapCommand {
+        TilemapChunkCache* tilemap_cache;
+        Region2D<int> visible_tiles;
+        Vector2D<int> camera_offset;
+        Vector2D<int> shake;
+    };
+
+private:
+    std::vector<Command> commands;
+    std::vector<TilemapCommand> tilemaps;
+};
 
 Vector2D<int> to_world_position(Vector2D<int> const& camera_position, Vector2D<int> const& size,
     Vector2D<int> const& camera_offset);
@@ -16,25 +111,32 @@ Vector2D<int> to_world_position(Vector2D<int> const& camera_position, Vector2D<i
 Vector2D<int> to_camera_position(Vector2D<int> const& world_position, Vector2D<int> const& size,
     Vector2D<int> const& camera_offset);
 
-void draw_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+// Tilemap region (columns in x/w, tilemap rows in y/h) that may be visible for the given camera offset
+Region2D<int> visible_tiles_region(Vector2D<int> const& camera_offset, int map_width, int map_height,
+    Vector2D<int> const& window_size = { SCREEN_WIDTH, SCREEN_HEIGHT });
+
+void draw_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& world_position, Vector2D<int> const& size, Vector2D<int> const& camera_offset,
     SDL_RendererFlip const& flip = SDL_FLIP_NONE);
 
-void draw_static_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+void draw_static_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& static_camera_position, Vector2D<int> const& size,
     SDL_RendererFlip const& flip = SDL_FLIP_NONE);
 
-void draw_direct_sprite(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& sprite_offset,
+void draw_direct_sprite(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& sprite_offset,
     Vector2D<int> const& sdlwindow_position, Vector2D<int> const& size);
 
-void draw_filled_region(SDL_Renderer* renderer, Region2D<int> const& region, RGBColor const& fill_color);
+void draw_sprite_rect(DrawList& draw_list, SpriteSheet const& spritesheet, SDL_Rect const& srcrect,
+    SDL_Rect const& sdlwindow_rect);
+
+void draw_filled_region(DrawList& draw_list, Region2D<int> const& region, RGBColor const& fill_color);
 
-void draw_line(SDL_Renderer* renderer, Vector2D<int> const& start_position, Vector2D<int> const& end_position,
+void draw_line(DrawList& draw_list, Vector2D<int> const& start_position, Vector2D<int> const& end_position,
     RGBColor const& fill_color);
 
 int gstr_width(std::string const& text);
 
-Region2D<int> gout(SDL_Renderer* renderer, SDL_Texture* spritesheet, Vector2D<int> const& static_camera_position,
+Region2D<int> gout(DrawList& draw_list, SpriteSheet const& spritesheet, Vector2D<int> const& static_camera_position,
     std::string const& message, RGBColor const& text_color, bool scale=true);
 
 template <typename T>
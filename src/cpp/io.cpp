@@ -1,5 +1,256 @@
 #include <io.hpp>
+#include <AssetPack.hpp>
+#include <MappedFile.hpp>
 #include <logging.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// Map file formats (native endianness):
+//
+// v1 (legacy, headerless): int width, int height, width * height int tile ids, int number of interactables, and
+//     then 4 ints per interactable (position x, position y, id, flip).
+// v2: MAP_MAGIC, uint32 version, int width, int height, uint32 number of tile runs, the (uint16 length,
+//     uint16 tile id) runs covering the whole tilemap row by row, and then the interactables as in v1.
+// v3: MAP_MAGIC, uint32 version, int width, int height, uint32 chunk columns, uint32 number of chunks, a
+//     ChunkEntry per chunk, the interactables as in v1, and then the tile runs of each chunk (covering the chunk
+//     row by row). Chunks are encoded independently, so that they can be read from the file one at a time.
+// v4: as v3, with a second ChunkEntry table (right after the first one) and runs for the trigger layer chunks.
+//     Maps in older formats have no triggers.
+//
+// A v1 file can't start with MAP_MAGIC, as that would be a map with an absurd width.
+
+namespace {
+    auto constexpr MAP_MAGIC = std::array<char, 4> { 'P', 'M', 'A', 'P' };
+    auto constexpr MAP_VERSION = std::uint32_t(4);
+    auto constexpr CHUNKED_MAP_VERSION = std::uint32_t(3);
+    auto constexpr RLE_MAP_VERSION = std::uint32_t(2);
+
+    struct TileRun {
+        std::uint16_t length;
+        TileId tile_id;
+    };
+    static_assert(sizeof(TileRun) == 4);
+
+    struct ChunkEntry {
+        std::uint64_t runs_offset;
+        std::uint32_t n_runs;
+        std::uint32_t padding;
+    };
+    static_assert(sizeof(ChunkEntry) == 16);
+
+    class MapWriter {
+    public:
+        template <typename T>
+        void write(T const& value)
+        {
+            this->write_bulk(std::span<T const>(&value, 1));
+        }
+
+        template <typename T>
+        void write_bulk(std::span<T const> values)
+        {
+            auto const* bytes = reinterpret_cast<char const*>(values.data());
+            this->buffer.insert(this->buffer.end(), bytes, bytes + values.size_bytes());
+        }
+
+        // Overwrites a value written earlier, at the given offset
+        template <typename T>
+        void write_at(std::size_t offset, T const& value)
+        {
+            std::memcpy(this->buffer.data() + offset, &value, sizeof(T));
+        }
+
+        std::vector<char> buffer;
+    };
+
+    class MapReader {
+    public:
+        MapReader(std::span<std::byte const> data, std::string const& filename)
+            : data(data)
+            , filename(filename)
+        {
+        }
+
+        template <typename T>
+        T read()
+        {
+            auto value = T {};
+            this->read_bulk(std::span<T>(&value, 1));
+            return value;
+        }
+
+        template <typename T>
+        void read_bulk(std::span<T> values)
+        {
+            if (values.size_bytes() > this->data.size()) {
+                err("Unexpected end of map file. filename="s + this->filename);
+            }
+            std::memcpy(values.data(), this->data.data(), values.size_bytes());
+            this->data = this->data.subspan(values.size_bytes());
+        }
+
+        // Checks the remaining bytes before allocating, so that a corrupt count can't request a huge buffer
+        template <typename T>
+        std::vector<T> read_vector(std::size_t count)
+        {
+            if (count > this->data.size() / sizeof(T)) {
+                err("Unexpected end of map file. filename="s + this->filename);
+            }
+            auto values = std::vector<T>(count);
+            this->read_bulk(std::span(values));
+            return values;
+        }
+
+        [[nodiscard]] bool starts_with(std::span<char const> bytes) const
+        {
+            return this->data.size() >= bytes.size() && std::memcmp(this->data.data(), bytes.data(), bytes.size()) == 0;
+        }
+
+    private:
+        std::span<std::byte const> data;
+        std::string const& filename;
+    };
+
+    // Chunk tables of a v3/v4 map file, enough to read any of its chunks later on
+    struct ChunkedMapIndex {
+        std::span<std::byte const> data;
+        std::vector<ChunkEntry> chunks;
+        // Empty in v3 map files
+        std::vector<ChunkEntry> trigger_chunks;
+        std::string filename;
+    };
+
+    std::vector<TileRun> encode_tiles(std::span<TileId const> tiles)
+    {
+        auto runs = std::vector<TileRun>();
+        for (auto tile : tiles) {
+            if (!runs.empty() && runs.back().tile_id == tile && runs.back().length < UINT16_MAX) {
+                runs.back().length++;
+            } else {
+                runs.push_back({ 1, tile });
+            }
+        }
+        return runs;
+    }
+
+    void decode_tiles(std::span<TileRun const> runs, std::span<TileId> tiles, std::string const& filename)
+    {
+        auto tile = tiles.begin();
+        for (auto const& run : runs) {
+            if (run.length > tiles.end() - tile) {
+                err("Tile data doesn't match the map size. filename="s + filename);
+            }
+            tile = std::fill_n(tile, run.length, run.tile_id);
+        }
+        if (tile != tiles.end()) {
+            err("Tile data doesn't match the map size. filename="s + filename);
+        }
+    }
+
+    void read_chunk(ChunkedMapIndex const& index, std::vector<ChunkEntry> const& table, int chunk,
+        std::span<TileId> tiles)
+    {
+        if (table.empty()) {
+            std::fill(tiles.begin(), tiles.end(), TileId(0));
+            return;
+        }
+        auto const& entry = table[chunk];
+        if (entry.runs_offset > index.data.size()) {
+            err("Unexpected end of map file. filename="s + index.filename);
+        }
+        auto reader = MapReader(index.data.subspan(entry.runs_offset), index.filename);
+        auto runs = reader.read_vector<TileRun>(entry.n_runs);
+        decode_tiles(runs, tiles, index.filename);
+    }
+
+    void read_map_size(MapReader& reader, GameMap& map, std::string const& filename)
+    {
+        map.width = reader.read<int>();
+        map.height = reader.read<int>();
+        if (map.width < 0 || map.height < 0) {
+            err("Invalid map size. filename="s + filename);
+        }
+        map.tilemap = Tilemap(map.width, map.height);
+        map.triggers = Tilemap(map.width, map.height);
+    }
+
+    void read_interactables(MapReader& reader, GameMap& map)
+    {
+        auto size = reader.read<int>();
+        auto raw_interactables = reader.read_vector<std::array<int, 4>>(std::max(size, 0));
+        for (auto const& [position_x, position_y, id, flip] : raw_interactables) {
+            map.interactables.push_back({ { position_x, position_y }, id, flip });
+        }
+    }
+
+    // Reads everything but the tiles of a v3/v4 map file (the reader must be past the version)
+    ChunkedMapIndex read_chunked_map_header(MapReader& reader, GameMap& map, std::uint32_t version,
+        std::span<std::byte const> data, std::string const& filename)
+    {
+        read_map_size(reader, map, filename);
+        auto chunk_columns = reader.read<std::uint32_t>();
+        auto n_chunks = reader.read<std::uint32_t>();
+        // The layout is checked before the chunk tables get allocated
+        if (chunk_columns != Tilemap::CHUNK_COLUMNS || n_chunks != std::uint32_t(map.tilemap.chunk_count())) {
+            err("Unsupported map chunk layout. filename="s + filename);
+        }
+        auto index = ChunkedMapIndex { data, reader.read_vector<ChunkEntry>(n_chunks), {}, filename };
+        if (version == MAP_VERSION) {
+            index.trigger_chunks = reader.read_vector<ChunkEntry>(n_chunks);
+        }
+        read_interactables(reader, map);
+        return index;
+    }
+
+    GameMap read_map(std::span<std::byte const> data, std::string const& filename)
+    {
+        auto reader = MapReader(data, filename);
+        auto map = GameMap { 0, 0 };
+
+        if (!reader.starts_with(MAP_MAGIC)) {
+            read_map_size(reader, map, filename);
+            auto raw_row = std::vector<int>(map.width);
+            auto row = std::vector<TileId>(map.width);
+            for (int i = 0; i < map.height; ++i) {
+                reader.read_bulk(std::span(raw_row));
+                std::copy(raw_row.begin(), raw_row.end(), row.begin());
+                map.tilemap.set_row(i, row);
+            }
+            read_interactables(reader, map);
+            return map;
+        }
+
+        reader.read<std::array<char, 4>>();
+        auto version = reader.read<std::uint32_t>();
+        if (version == RLE_MAP_VERSION) {
+            read_map_size(reader, map, filename);
+            auto runs = std::vector<TileRun>(reader.read<std::uint32_t>());
+            reader.read_bulk(std::span(runs));
+            auto tiles = std::vector<TileId>(std::size_t(map.width) * map.height);
+            decode_tiles(runs, tiles, filename);
+            for (int i = 0; i < map.height; ++i) {
+                map.tilemap.set_row(i, std::span(tiles).subspan(std::size_t(i) * map.width, map.width));
+            }
+            read_interactables(reader, map);
+        } else if (version == MAP_VERSION || version == CHUNKED_MAP_VERSION) {
+            auto index = read_chunked_map_header(reader, map, version, data, filename);
+            auto tiles = std::vector<TileId>();
+            for (int chunk = 0; chunk < map.tilemap.chunk_count(); ++chunk) {
+                tiles.resize(std::size_t(map.tilemap.chunk_width(chunk)) * map.height);
+                read_chunk(index, index.chunks, chunk, tiles);
+                map.tilemap.set_chunk(chunk, tiles);
+                read_chunk(index, index.trigger_chunks, chunk, tiles);
+                map.triggers.set_chunk(chunk, tiles);
+            }
+        } else {
+            err("Unsupported map file version "s + std::to_string(version) + ". filename="s + filename);
+        }
+        return map;
+    }
+}
 
 void save_map(GameMap const& map, std::string const& filename)
 {
@@ -7,61 +258,88 @@ void save_map(GameMap const& map, std::string const& filename)
     if (!mapfile.is_open()) {
         err("Could not open file to write. filename="s + filename);
     }
-    auto bin_write = [&mapfile](int const& data) { mapfile.write(reinterpret_cast<const char*>(&data), sizeof(int)); };
 
-    bin_write(map.width);
-    bin_write(map.height);
-    for (int i = 0; i < map.height; ++i) {
-        for (int j = 0; j < map.width; ++j) {
-            bin_write(map.tilemap[i][j]);
+    auto writer = MapWriter();
+    writer.write(MAP_MAGIC);
+    writer.write(MAP_VERSION);
+    writer.write(map.width);
+    writer.write(map.height);
+    writer.write(std::uint32_t(Tilemap::CHUNK_COLUMNS));
+    writer.write(std::uint32_t(map.tilemap.chunk_count()));
+    // Both chunk tables are filled in once the runs are written
+    auto chunk_table_offset = writer.buffer.size();
+    auto chunk_table = std::vector<ChunkEntry>(2 * map.tilemap.chunk_count());
+    writer.write_bulk(std::span<ChunkEntry const>(chunk_table));
+    writer.write(int(map.interactables.size()));
+    for (auto const& interactable : map.interactables) {
+        writer.write(std::array<int, 4> { interactable.position.x, interactable.position.y, interactable.id, interactable.flip });
+    }
+    auto entry = chunk_table.begin();
+    auto tiles = std::vector<TileId>();
+    for (auto const* layer : { &map.tilemap, &map.triggers }) {
+        for (int chunk = 0; chunk < layer->chunk_count(); ++chunk) {
+            tiles.resize(std::size_t(layer->chunk_width(chunk)) * map.height);
+            layer->read_chunk(chunk, tiles);
+            auto runs = encode_tiles(tiles);
+            *entry++ = ChunkEntry { writer.buffer.size(), std::uint32_t(runs.size()), 0 };
+            writer.write_bulk(std::span<TileRun const>(runs));
         }
     }
-    bin_write(map.interactables.size());
-    for (auto const& interactable : map.interactables) {
-        bin_write(interactable.position.x);
-        bin_write(interactable.position.y);
-        bin_write(interactable.id);
-        bin_write(interactable.flip);
+    for (std::size_t i = 0; i < chunk_table.size(); ++i) {
+        writer.write_at(chunk_table_offset + i * sizeof(ChunkEntry), chunk_table[i]);
     }
+
+    mapfile.write(writer.buffer.data(), writer.buffer.size());
     mapfile.close();
 }
 
 GameMap load_map(std::string const& filename)
 {
-    std::ifstream mapfile(filename, std::ios::binary | std::ios::in);
+    if (auto entry = asset_pack.find(filename)) {
+        return read_map(entry->data, filename);
+    }
+
+    std::ifstream mapfile(filename, std::ios::binary | std::ios::in | std::ios::ate);
     if (!mapfile.is_open()) {
         err("Could not load file to read. filename="s + filename);
     }
+    auto contents = std::vector<std::byte>(mapfile.tellg());
+    mapfile.seekg(0);
+    mapfile.read(reinterpret_cast<char*>(contents.data()), contents.size());
+    return read_map(contents, filename);
+}
 
-    auto bin_read_nextint = [&mapfile](int& target) { mapfile.read(reinterpret_cast<char*>(&target), sizeof(int)); };
-
-    auto map = GameMap { 0, 0 };
-
-    bin_read_nextint(map.width);
-    bin_read_nextint(map.height);
-
-    map.tilemap = std::vector<std::vector<int>>(map.height, std::vector<int>(map.width));
-    for (int i = 0; i < map.height; ++i) {
-        for (int j = 0; j < map.width; ++j) {
-            bin_read_nextint(map.tilemap[i][j]);
-        }
+GameMap stream_map(std::string const& filename)
+{
+    // The mapping is shared with the tilemap chunk loader, which keeps it alive
+    auto file = std::make_shared<MappedFile>();
+    auto data = std::span<std::byte const>();
+    if (auto entry = asset_pack.find(filename)) {
+        data = entry->data;
+    } else if (file->open(filename)) {
+        data = file->data();
+    } else {
+        err("Could not load file to read. filename="s + filename);
     }
 
-    int size = 0;
-    bin_read_nextint(size);
-    int position_x = 0;
-    int position_y = 0;
-    int id = 0;
-    int flip = 0;
-    for (int i = 0; i < size; ++i) {
-        bin_read_nextint(position_x);
-        bin_read_nextint(position_y);
-        bin_read_nextint(id);
-        bin_read_nextint(flip);
-        map.interactables.push_back({ { position_x, position_y }, id, flip });
+    auto reader = MapReader(data, filename);
+    if (!reader.starts_with(MAP_MAGIC)) {
+        return read_map(data, filename);
+    }
+    reader.read<std::array<char, 4>>();
+    auto version = reader.read<std::uint32_t>();
+    if (version != MAP_VERSION && version != CHUNKED_MAP_VERSION) {
+        // Older formats can't be read chunk by chunk
+        return read_map(data, filename);
     }
 
-    mapfile.close();
-
+    auto map = GameMap { 0, 0 };
+    auto index = std::make_shared<ChunkedMapIndex const>(read_chunked_map_header(reader, map, version, data, filename));
+    map.tilemap = Tilemap(map.width, map.height, [file, index](int chunk, std::span<TileId> tiles) {
+        read_chunk(*index, index->chunks, chunk, tiles);
+    });
+    map.triggers = Tilemap(map.width, map.height, [file, index](int chunk, std::span<TileId> tiles) {
+        read_chunk(*index, index->trigger_chunks, chunk, tiles);
+    });
     return map;
 }
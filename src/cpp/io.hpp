@@ -8,8 +8,15 @@
 #include <string>
 #include <vector>
 
+// Always writes the latest map format (v4, see io.cpp)
 void save_map(GameMap const& map, std::string const& filename);
 
+// Reads the map from the asset pack when it is there, otherwise from the map file. Any map format version is
+// accepted.
 GameMap load_map(std::string const& filename);
 
+// Same as load_map, but the tiles of chunked (v3 and later) map files are only read as they are accessed, straight from the
+// memory mapped file, and only a bounded number of tile chunks is kept in memory (see Tilemap).
+GameMap stream_map(std::string const& filename);
+
 #endif
@@ -2,6 +2,7 @@
 #define PIGSGAME_KEY_H
 
 #include <characters/IGameCharacter.hpp>
+#include <AssetsRegistry.hpp>
 #include <Animation.hpp>
 #include <SceneScript.hpp>
 #include <Vector2D.hpp>
@@ -10,28 +11,22 @@
 
 class Key : public IGameCharacter {
 public:
+    static auto constexpr CHARACTER_TYPE = CharacterType::KEY;
     static auto constexpr collision_size = Vector2D<int> { 18, 18 };
     static auto constexpr IDLE_ANIMATION = 0;
     static auto constexpr SPRITESHEET_OFFSET = Vector2D<int> { 0, 0 };
 
-    Key(SDL_Renderer* renderer, double pos_x, double pos_y);
+    Key(World& world, double pos_x, double pos_y);
 
     void update(double elapsedTime) override;
-    void run_animation(double elapsedTime, Vector2D<int> const& camera_offset) override;
-    void set_position(double x, double y) override;
-    Vector2D<double> get_position() const override;
-    Vector2D<double> get_velocity() const override;
-    void set_velocity(double x, double y) override;
+    void run_animation(DrawList& draw_list, double elapsedTime, double interpolation, Vector2D<int> const& camera_offset) override;
     void handle_collision(CollisionType const& type, CollisionSide const& side) override;
-    CollisionRegionInformation get_collision_region_information() const override;
     void on_after_collision() override;
 
     void collect();
 
 public:
-    Vector2D<double> position;
-    SDL_Renderer* renderer;
-    SDL_Texture* spritesheet;
+    TextureRef spritesheet;
     bool is_collected;
     std::map<int, Animation> animations;
 };
@@ -1,3 +1,4 @@
+#include <AssetsRegistry.hpp>
 #include <GameHandler.hpp>
 #include <TransitionAnimation.hpp>
 #include <characters/IGameCharacter.hpp>
@@ -6,14 +7,35 @@
 #include <levels/EntryLevel.hpp>
 #include <levels/Level2.hpp>
 #include <screens/GameScreen.hpp>
-#include <SoundHandler.hpp>
 
 EntryLevel::EntryLevel(GameHandler& game_handler)
-    : map(load_map("maps/entry_level.map"))
-    , characters(build_game_characters(game_handler.get_renderer(), map))
+    : map(stream_map("maps/entry_level.map"))
+    , static_colliders(map, assets_registry.tileset_properties)
+    , trigger_zones(map, assets_registry.tileset_properties)
+    , world(static_colliders)
     , game_handler(game_handler)
 {
-    sound_handler.play_music("forest");
+    build_game_characters(this->world, this->map);
+
+    // Level exit. Retried while Liv stays in the zone, as a transition may still be running when she enters it.
+    this->trigger_zones.bind(1, [&game_handler](IGameCharacter* character, TriggerEvent event) {
+        if (character->character_type != CharacterType::LIV || event == TriggerEvent::EXIT) {
+            return;
+        }
+        auto& transition = game_handler.get_transition_animation();
+        if (transition.current_state() == TransitionAnimationState::finished) {
+            transition.register_transition_loader<IGameLevel>(
+                [&game_handler]() -> std::unique_ptr<IGameLevel> {
+                    return std::make_unique<Level2>(game_handler);
+                },
+                [&game_handler](std::unique_ptr<IGameLevel>&& level) {
+                    auto game_screen = dynamic_cast<GameScreen*>(game_handler.get_active_screen());
+                    game_screen->set_active_level(std::move(level));
+                }
+            );
+            transition.reset();
+        }
+    });
 }
 
 GameMap& EntryLevel::get_map()
@@ -21,31 +43,17 @@ GameMap& EntryLevel::get_map()
     return this->map;
 }
 
-std::vector<std::unique_ptr<IGameCharacter>>& EntryLevel::get_characters()
+StaticColliders const& EntryLevel::get_static_colliders() const
 {
-    return this->characters;
+    return this->static_colliders;
 }
 
-std::function<void()> EntryLevel::get_collision_callback(int callback_collision_id, IGameCharacter* character)
+TriggerZones& EntryLevel::get_trigger_zones()
 {
-    if (callback_collision_id == 1) {
-        if (dynamic_cast<Liv*>(character) == nullptr) {
-            return nullptr;
-        }
+    return this->trigger_zones;
+}
 
-        auto& game_handler = this->game_handler;
-        return [&game_handler]() {
-            auto& transition = game_handler.get_transition_animation();
-            if (transition.current_state() == TransitionAnimationState::finished) {
-                transition.register_transition_callback(
-                    [&]() {
-                        auto game_screen = dynamic_cast<GameScreen*>(game_handler.get_active_screen());
-                        game_screen->set_active_level(std::make_unique<Level2>(game_handler));
-                    }
-                );
-                transition.reset();
-            }
-        };
-    }
-    return nullptr;
+World& EntryLevel::get_world()
+{
+    return this->world;
 }
@@ -3,6 +3,9 @@
 
 #include <GameMap.hpp>
 #include <characters/IGameCharacter.hpp>
+#include <characters/World.hpp>
+#include <collision/StaticColliders.hpp>
+#include <collision/TriggerZones.hpp>
 #include <functional>
 #include <vector>
 #include <memory>
@@ -10,8 +13,9 @@
 class IGameLevel {
 public:
     virtual GameMap& get_map() = 0;
-    virtual std::vector<std::unique_ptr<IGameCharacter>>& get_characters() = 0;
-    virtual std::function<void()> get_collision_callback(int callback_collision_id, IGameCharacter* character) = 0;
+    virtual StaticColliders const& get_static_colliders() const = 0;
+    virtual TriggerZones& get_trigger_zones() = 0;
+    virtual World& get_world() = 0;
 };
 
 #endif
@@ -1,3 +1,4 @@
+#include <AssetsRegistry.hpp>
 #include <GameHandler.hpp>
 #include <TransitionAnimation.hpp>
 #include <characters/IGameCharacter.hpp>
@@ -7,12 +8,38 @@
 #include <levels/EntryLevel.hpp>
 #include <levels/Level2.hpp>
 #include <screens/GameScreen.hpp>
+#include <SoundHandler.hpp>
 
 Level2::Level2(GameHandler& game_handler)
-    : map(load_map("maps/level2.map"))
-    , characters(build_game_characters(game_handler.get_renderer(), map))
+    : map(stream_map("maps/level2.map"))
+    , static_colliders(map, assets_registry.tileset_properties)
+    , trigger_zones(map, assets_registry.tileset_properties)
+    , world(static_colliders)
     , game_handler(game_handler)
 {
+    build_game_characters(this->world, this->map);
+
+    // Level exit. Retried while Liv stays in the zone, as a transition may still be running when she enters it.
+    this->trigger_zones.bind(1, [&game_handler](IGameCharacter* character, TriggerEvent event) {
+        if (character->character_type != CharacterType::LIV || event == TriggerEvent::EXIT) {
+            return;
+        }
+        auto& transition = game_handler.get_transition_animation();
+        if (transition.current_state() == TransitionAnimationState::finished) {
+            transition.register_transition_loader<IGameLevel>(
+                [&game_handler]() -> std::unique_ptr<IGameLevel> {
+                    return std::make_unique<EntryLevel>(game_handler);
+                },
+                [&game_handler](std::unique_ptr<IGameLevel>&& level) {
+                    // Levels are built on a loader thread, the music only changes once the level is swapped in
+                    sound_handler.play_music("forest");
+                    auto game_screen = dynamic_cast<GameScreen*>(game_handler.get_active_screen());
+                    game_screen->set_active_level(std::move(level));
+                }
+            );
+            transition.reset();
+        }
+    });
 }
 
 GameMap& Level2::get_map()
@@ -20,31 +47,17 @@ GameMap& Level2::get_map()
     return this->map;
 }
 
-std::vector<std::unique_ptr<IGameCharacter>>& Level2::get_characters()
+StaticColliders const& Level2::get_static_colliders() const
 {
-    return this->characters;
+    return this->static_colliders;
 }
 
-std::function<void()> Level2::get_collision_callback(int callback_collision_id, IGameCharacter* character)
+TriggerZones& Level2::get_trigger_zones()
 {
-    if (callback_collision_id == 1) {
-        if (dynamic_cast<Liv*>(character) == nullptr) {
-            return nullptr;
-        }
+    return this->trigger_zones;
+}
 
-        auto& game_handler = this->game_handler;
-        return [&game_handler]() {
-            auto& transition = game_handler.get_transition_animation();
-            if (transition.current_state() == TransitionAnimationState::finished) {
-                transition.register_transition_callback(
-                    [&]() {
-                        auto game_screen = dynamic_cast<GameScreen*>(game_handler.get_active_screen());
-                        game_screen->set_active_level(std::make_unique<EntryLevel>(game_handler));
-                    }
-                );
-                transition.reset();
-            }
-        };
-    }
-    return nullptr;
+World& Level2::get_world()
+{
+    return this->world;
 }
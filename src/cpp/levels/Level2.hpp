@@ -18,12 +18,15 @@ public:
     Level2(GameHandler& game_handler);
 
     GameMap& get_map() override;
-    std::vector<std::unique_ptr<IGameCharacter>>& get_characters() override;
-    std::function<void()> get_collision_callback(int callback_collision_id, IGameCharacter* character) override;
+    StaticColliders const& get_static_colliders() const override;
+    TriggerZones& get_trigger_zones() override;
+    World& get_world() override;
 
 private:
     GameMap map;
-    std::vector<std::unique_ptr<IGameCharacter>> characters;
+    StaticColliders static_colliders;
+    TriggerZones trigger_zones;
+    World world;
     GameHandler& game_handler;
 };
 
@@ -1,3 +1,4 @@
+#include <AssetsRegistry.hpp>
 #include <GameHandler.hpp>
 #include <TransitionAnimation.hpp>
 #include <characters/IGameCharacter.hpp>
@@ -7,10 +8,13 @@
 #include <levels/PreludeLevel.hpp>
 
 PreludeLevel::PreludeLevel(GameHandler& game_handler)
-    : map(load_map("maps/intro.map"))
-    , characters(build_game_characters(game_handler.get_renderer(), map))
+    : map(stream_map("maps/intro.map"))
+    , static_colliders(map, assets_registry.tileset_properties)
+    , trigger_zones(map, assets_registry.tileset_properties)
+    , world(static_colliders)
 {
-    prepare_script(this->characters, game_handler.get_transition_animation());
+    build_game_characters(this->world, this->map);
+    prepare_script(this->world, game_handler.get_transition_animation());
 }
 
 GameMap& PreludeLevel::get_map()
@@ -18,21 +22,26 @@ GameMap& PreludeLevel::get_map()
     return this->map;
 }
 
-std::vector<std::unique_ptr<IGameCharacter>>& PreludeLevel::get_characters()
+StaticColliders const& PreludeLevel::get_static_colliders() const
 {
-    return this->characters;
+    return this->static_colliders;
 }
 
-std::function<void()> PreludeLevel::get_collision_callback(int callback_collision_id, IGameCharacter* character)
+TriggerZones& PreludeLevel::get_trigger_zones()
 {
-    return nullptr;
+    return this->trigger_zones;
 }
 
-void prepare_script(std::vector<std::unique_ptr<IGameCharacter>>& game_characters, TransitionAnimation& transition_animation)
+World& PreludeLevel::get_world()
 {
-    auto pig1 = dynamic_cast<Pig*>(game_characters[0].get());
-    auto pig2 = dynamic_cast<Pig*>(game_characters[1].get());
-    auto pig3 = dynamic_cast<Pig*>(game_characters[2].get());
+    return this->world;
+}
+
+void prepare_script(World& world, TransitionAnimation& transition_animation)
+{
+    auto pig1 = dynamic_cast<Pig*>(world.characters[0].get());
+    auto pig2 = dynamic_cast<Pig*>(world.characters[1].get());
+    auto pig3 = dynamic_cast<Pig*>(world.characters[2].get());
 
     auto pig1_color = RGBColor { 0, 100, 0 };
     auto pig2_color = RGBColor { 250, 50, 50 };
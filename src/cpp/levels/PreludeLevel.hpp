@@ -38,19 +38,22 @@ static std::map<std::string, std::string> tr = {
     { "AND START WORKING??", "E COMECAR A TRABALHAR??" }
 };
 
-void prepare_script(std::vector<std::unique_ptr<IGameCharacter>>& game_characters, TransitionAnimation& transition_animation);
+void prepare_script(World& world, TransitionAnimation& transition_animation);
 
 class PreludeLevel : public IGameLevel {
 public:
     explicit PreludeLevel(GameHandler& game_handler);
 
     GameMap& get_map() override;
-    std::vector<std::unique_ptr<IGameCharacter>>& get_characters() override;
-    std::function<void()> get_collision_callback(int callback_collision_id, IGameCharacter* character) override;
+    StaticColliders const& get_static_colliders() const override;
+    TriggerZones& get_trigger_zones() override;
+    World& get_world() override;
 
 private:
     GameMap map;
-    std::vector<std::unique_ptr<IGameCharacter>> characters;
+    StaticColliders static_colliders;
+    TriggerZones trigger_zones;
+    World world;
 };
 
 #endif
@@ -5,16 +5,27 @@
 #include <iostream>
 
 #define ENABLE_WARNINGS 1
+// Startup summaries (asset decoding, texture atlas, colliders), off unless built with -DENABLE_INFO=1
+#ifndef ENABLE_INFO
+#define ENABLE_INFO 0
+#endif
 
 using namespace std::string_literals;
 
 inline void warn(std::string const& message)
 {
-#ifdef ENABLE_WARNINGS
+#if ENABLE_WARNINGS
     std::cout << "[WARNING]: "s + message + "\n"s;
 #endif
 }
 
+inline void info([[maybe_unused]] std::string const& message)
+{
+#if ENABLE_INFO
+    std::cout << "[INFO]: "s + message + "\n"s;
+#endif
+}
+
 inline void err(std::string const& message)
 {
     throw std::runtime_error("[ERROR]: "s + message + "\n"s);
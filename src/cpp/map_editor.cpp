@@ -1,6 +1,7 @@
 #include <SDL.h>
 
 #include <GameMap.hpp>
+#include <TilemapChunkCache.hpp>
 #include <Vector2D.hpp>
 #include <collision/aabb.hpp>
 #include <constants.hpp>
@@ -11,10 +12,12 @@
 #include <sdl_wrappers.hpp>
 #include <string>
 #include <vector>
+#include <memory>
 #include <optional>
 
 auto constexpr BACKGROUND_SECTION = 1;
 auto constexpr INTERACTABLES_SECTION = 3;
+auto constexpr TRIGGERS_SECTION = 4;
 
 auto constexpr LIGHT_GRAY_COLOR = RGBColor { 102, 102, 102 };
 auto constexpr GRAY_COLOR = RGBColor { 72, 72, 72 };
@@ -119,13 +122,12 @@ public:
         }
     }
 
-    void draw()
+    void draw(DrawList& draw_list)
     {
-        SDL_SetRenderDrawColor(this->sdl_renderer, this->color.r, this->color.g, this->color.b, 255);
-        SDL_RenderFillRect(this->sdl_renderer, &this->sdl_region);
+        draw_filled_region(draw_list, this->region, this->color);
 
         auto srcrect = SDL_Rect { 0, 0, this->sdl_region.w, this->sdl_region.h };
-        SDL_RenderCopy(this->sdl_renderer, this->sdl_image, &srcrect, &this->sdl_region);
+        draw_list.add(this->sdl_image, srcrect, this->sdl_region);
     }
 
     void register_on_mouse_in(std::function<void(Button& self, MouseState const&)> const& f)
@@ -168,6 +170,7 @@ public:
         : camera_offset { 0, 0 }
         , map(map)
         , mouse { { 0, 0 }, false, false, false }
+        , draw_list()
         , quit(false)
         , selected_section(BACKGROUND_SECTION)
         , selected_tile(-1)
@@ -180,7 +183,7 @@ public:
             throw std::runtime_error("SDL Error: Window could not be created");
         }
 
-        this->sdl_renderer = SDL_CreateRenderer(this->sdl_window, -1, SDL_RENDERER_ACCELERATED);
+        this->sdl_renderer = SDL_CreateRenderer(this->sdl_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
         SDL_SetRenderDrawBlendMode(this->sdl_renderer, SDL_BLENDMODE_BLEND);
 
         this->camera_offset.x = -int(this->map.width * TILE_SIZE / 2);
@@ -190,6 +193,7 @@ public:
             return load_media("assets/sprites/" + filename, this->sdl_renderer);
         };
         this->tileset = load_spritesheet("tiles.png");
+        this->tilemap_cache = std::make_unique<TilemapChunkCache>(this->map, this->tileset);
         this->interactables_set = load_media("assets/map_editor/interactables.png", this->sdl_renderer);
         this->monogram = load_spritesheet("monogram.png");
 
@@ -221,16 +225,15 @@ public:
         this->tmI = Button(this->sdl_renderer, { 52, 460 }, { 14, 14 }, PURPLE_COLOR, "assets/map_editor/tmI.png");
         this->tmI.register_on_mouse_clicked(
             [this](Button&, MouseState const&) { this->selected_section = INTERACTABLES_SECTION; });
+        this->tmT = Button(this->sdl_renderer, { 84, 460 }, { 14, 14 }, PURPLE_COLOR, "assets/map_editor/tmT.png");
+        this->tmT.register_on_mouse_clicked(
+            [this](Button&, MouseState const&) { this->selected_section = TRIGGERS_SECTION; });
 
         this->fill_all_button = Button(this->sdl_renderer, { 134, 460 }, { 14, 14 }, PURPLE_COLOR, "assets/map_editor/fill_all.png");
         this->fill_all_button.register_on_mouse_clicked([this](Button&, MouseState const&) {
             if (mouse.just_left_clicked && this->selected_tile != -1 && this->selected_section == BACKGROUND_SECTION) {
-                auto* selected_tilemap = &this->map.tilemap;
-                for (int i = 0; i < this->map.height; ++i) {
-                    for (int j = 0; j < this->map.width; ++j) {
-                        (*selected_tilemap)[i][j] = this->selected_tile;
-                    }
-                }
+                this->map.tilemap.fill(TileId(this->selected_tile));
+                this->tilemap_cache->fill(TileId(this->selected_tile));
             }
         });
 
@@ -248,6 +251,7 @@ public:
 
     ~MapEditorWindow()
     {
+        this->tilemap_cache.reset();
         SDL_DestroyWindow(this->sdl_window);
         SDL_DestroyRenderer(this->sdl_renderer);
     }
@@ -270,11 +274,19 @@ private:
 
         this->tm0.update(this->mouse);
         this->tmI.update(this->mouse);
+        this->tmT.update(this->mouse);
         this->fill_all_button.update(this->mouse);
         this->left_arrow_button.update(this->mouse);
         this->right_arrow_button.update(this->mouse);
     }
 
+    // Draws everything recorded so far, before drawing straight with SDL (or presenting)
+    void submit_drawing()
+    {
+        this->draw_list.submit(this->sdl_renderer);
+        this->draw_list.reset();
+    }
+
     bool check_mouse_is_over(Region2D<int> region)
     {
         return check_aabb_collision(region.as<double>(),
@@ -293,6 +305,14 @@ private:
                 break;
             }
 
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET: {
+                if (this->tilemap_cache) {
+                    this->tilemap_cache->invalidate_all();
+                }
+                break;
+            }
+
             case SDL_MOUSEMOTION: {
                 if (e.motion.state & SDL_BUTTON_RMASK) {
                     this->camera_offset.x -= e.motion.xrel;
@@ -341,23 +361,19 @@ private:
         this->draw_top_panel();
         this->draw_bottom_panel();
 
+        this->submit_drawing();
         SDL_RenderPresent(this->sdl_renderer);
     }
 
     void draw_main_region()
     {
-        for (int i = 0; i < map.height; ++i) {
-            for (int j = 0; j < map.width; ++j) {
-                auto world_position = Vector2D<int> { TILE_SIZE * j, TILE_SIZE * (map.height - i - 1) };
-
-                // Background
-                {
-                    auto tile_id = map.tilemap[i][j];
-                    auto offset = Vector2D<int> { TILE_SIZE * (tile_id % 4), TILE_SIZE * int(floor(tile_id / 4)) };
-                    auto size = Vector2D<int> { TILE_SIZE, TILE_SIZE };
-                        draw_sprite(this->sdl_renderer, this->tileset, offset, world_position, size, camera_offset);
-                }
-            }
+        // Background
+        {
+            int window_w = 0;
+            int window_h = 0;
+            SDL_GetWindowSize(this->sdl_window, &window_w, &window_h);
+            auto visible_tiles = visible_tiles_region(camera_offset, map.width, map.height, { window_w, window_h });
+            this->tilemap_cache->draw(this->sdl_renderer, visible_tiles, camera_offset);
         }
 
         // Interactables
@@ -367,7 +383,7 @@ private:
                 auto offset = Vector2D<int> { TILE_SIZE * (interactable_info.id % 7),
                     TILE_SIZE * int(floor(interactable_info.id / 7)) };
                 auto world_position = interactable_info.position;
-                draw_sprite(this->sdl_renderer, this->interactables_set, offset, world_position, size, camera_offset);
+                draw_sprite(this->draw_list, this->interactables_set, offset, world_position, size, camera_offset);
             }
         }
 
@@ -375,19 +391,35 @@ private:
             for (int j = 0; j < map.width; ++j) {
                 auto world_position = Vector2D<int> { TILE_SIZE * j, TILE_SIZE * (map.height - i - 1) };
 
+                // Trigger zones overlay
+                if (selected_section == TRIGGERS_SECTION && this->map.triggers(i, j) != 0) {
+                    auto camera_position = to_camera_position(world_position, { TILE_SIZE, TILE_SIZE }, camera_offset);
+                    auto sdl_rect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * TILE_SIZE, SCALE_SIZE * TILE_SIZE };
+                    this->submit_drawing();
+                    SDL_SetRenderDrawColor(this->sdl_renderer, 250, 200, 150, 90);
+                    SDL_RenderFillRect(this->sdl_renderer, &sdl_rect);
+                    gout(this->draw_list, this->monogram, { camera_position.x + 2, camera_position.y + 2 },
+                        std::to_string(this->map.triggers(i, j)), { 255, 255, 255 }, false);
+                }
+
                 // Check if selected
                 {
                     auto camera_position = to_camera_position(world_position, { TILE_SIZE, TILE_SIZE }, camera_offset);
                     auto tile_region = Region2D<int> { camera_position.x, camera_position.y, SCALE_SIZE * TILE_SIZE, SCALE_SIZE * TILE_SIZE };
                     if (this->check_mouse_is_over(tile_region)) {
+                        this->submit_drawing();
                         SDL_SetRenderDrawColor(this->sdl_renderer, 250, 255, 255, 255);
                         auto sdl_rect = to_sdl_rect(tile_region);
                         SDL_RenderDrawRect(this->sdl_renderer, &sdl_rect);
 
                         if (this->mouse.left_clicked && this->selected_tile != -1) {
                             if (this->mouse.position.x > LEFT_PANEL_WIDTH) {
-                                if (selected_section == BACKGROUND_SECTION) {
-                                    this->map.tilemap[i][j] = this->selected_tile;
+                                if (selected_section == BACKGROUND_SECTION && this->map.tilemap(i, j) != this->selected_tile) {
+                                    this->map.tilemap.set(i, j, TileId(this->selected_tile));
+                                    this->tilemap_cache->set_tile(i, j, TileId(this->selected_tile));
+                                }
+                                if (selected_section == TRIGGERS_SECTION) {
+                                    this->map.triggers.set(i, j, TileId(this->selected_tile));
                                 }
                             }
                         }
@@ -400,6 +432,11 @@ private:
                             }
                         }
 
+                        if (this->mouse.right_clicked && this->mouse.position.x > LEFT_PANEL_WIDTH) {
+                            if (selected_section == TRIGGERS_SECTION) {
+                                this->map.triggers.set(i, j, 0);
+                            }
+                        }
                         if (this->mouse.just_right_clicked) {
                             if (selected_section == INTERACTABLES_SECTION) {
                                 this->map.interactables.erase(
@@ -418,6 +455,7 @@ private:
 
         // Drawable region border
         {
+            this->submit_drawing();
             SDL_SetRenderDrawColor(this->sdl_renderer, 250, 200, 150, 255);
             auto map_size = Vector2D<int> { TILE_SIZE * map.width, TILE_SIZE * map.height };
             auto map_position = to_camera_position({ 0, 0 }, map_size, camera_offset);
@@ -434,10 +472,12 @@ private:
         auto size = Vector2D<int> { TILE_SIZE, TILE_SIZE };
         if (this->selected_section == BACKGROUND_SECTION) {
             auto offset = Vector2D<int> { TILE_SIZE * (selected_tile % 4), TILE_SIZE * int(floor(selected_tile / 4)) };
-            draw_sprite(this->sdl_renderer, this->tileset, offset, world_mouse, size, camera_offset);
+            draw_sprite(this->draw_list, this->tileset, offset, world_mouse, size, camera_offset);
         } else if (this->selected_section == INTERACTABLES_SECTION) {
             auto offset = Vector2D<int> { TILE_SIZE * (selected_tile % 7), TILE_SIZE * int(floor(selected_tile / 7)) };
-            draw_sprite(this->sdl_renderer, this->interactables_set, offset, world_mouse, size, camera_offset);
+            draw_sprite(this->draw_list, this->interactables_set, offset, world_mouse, size, camera_offset);
+        } else if (this->selected_section == TRIGGERS_SECTION && selected_tile != -1) {
+            gout(this->draw_list, this->monogram, this->mouse.position, std::to_string(selected_tile), { 255, 255, 255 }, false);
         }
     }
 
@@ -446,12 +486,12 @@ private:
         int window_w = 0;
         int window_h = 0;
         SDL_GetWindowSize(this->sdl_window, &window_w, &window_h);
-        draw_filled_region(this->sdl_renderer, { 0, 0, window_w, 30 }, GRAY_COLOR);
-        draw_line(this->sdl_renderer, { 0, 30 }, { window_w, 30 }, DARK_PURPLE_COLOR);
+        draw_filled_region(this->draw_list, { 0, 0, window_w, 30 }, GRAY_COLOR);
+        draw_line(this->draw_list, { 0, 30 }, { window_w, 30 }, DARK_PURPLE_COLOR);
 
-        this->new_button.draw();
-        this->load_button.draw();
-        this->save_button.draw();
+        this->new_button.draw(this->draw_list);
+        this->load_button.draw(this->draw_list);
+        this->save_button.draw(this->draw_list);
     }
 
     void draw_bottom_panel()
@@ -459,15 +499,13 @@ private:
         int window_w = 0;
         int window_h = 0;
         SDL_GetWindowSize(this->sdl_window, &window_w, &window_h);
-        SDL_SetRenderDrawColor(this->sdl_renderer, 90, 80, 100, 255);
-        auto fixed_rect = SDL_Rect { 0, window_h - 20, window_w, 20 };
-        SDL_RenderFillRect(this->sdl_renderer, &fixed_rect);
+        draw_filled_region(this->draw_list, { 0, window_h - 20, window_w, 20 }, RGBColor { 90, 80, 100 });
 
         auto mouse_on_world = to_world_position(this->mouse.position, { 0, 0 }, camera_offset);
         auto message = this->map_filename + " [" + std::to_string(this->map.width) + "x" + std::to_string(this->map.height) + "]"
                                                                                                                               " . Mouse position: "
             + std::to_string(mouse_on_world.x) + ", " + std::to_string(mouse_on_world.y) + " . " + this->bottom_panel_message;
-        gout(this->sdl_renderer, this->monogram, { 5, window_h - 15 }, message, { 255, 255, 255 }, false);
+        gout(this->draw_list, this->monogram, { 5, window_h - 15 }, message, { 255, 255, 255 }, false);
     }
 
     void draw_left_panel()
@@ -475,10 +513,10 @@ private:
         int window_w = 0;
         int window_h = 0;
         SDL_GetWindowSize(this->sdl_window, &window_w, &window_h);
-        draw_filled_region(this->sdl_renderer, { 0, 0, LEFT_PANEL_WIDTH, window_h }, DARK_PURPLE_COLOR);
+        draw_filled_region(this->draw_list, { 0, 0, LEFT_PANEL_WIDTH, window_h }, DARK_PURPLE_COLOR);
 
         // Tiles tab
-        draw_filled_region(this->sdl_renderer, { 10, 50, 180, 430 }, PURPLE_COLOR);
+        draw_filled_region(this->draw_list, { 10, 50, 180, 430 }, PURPLE_COLOR);
         auto constexpr MAX_X = 4;
         auto constexpr MAX_Y = 9;
         auto constexpr MAX_ELEMS = MAX_X * MAX_Y;
@@ -495,7 +533,8 @@ private:
         int w = 0;
         int h = 0;
         SDL_QueryTexture(selected_tileset, nullptr, nullptr, &w, &h);
-        auto n_tiles_per_line = w / TILE_SIZE;
+        // Trigger zones have no tileset, the ids are laid out in rows
+        auto n_tiles_per_line = selected_tileset != nullptr ? w / TILE_SIZE : MAX_X;
 
         auto x_offset = 0;
         auto y_offset = 0;
@@ -509,14 +548,19 @@ private:
             auto tile_id = this->start_tile_id + ((i / MAX_X) * n_tiles_per_line) + (i % MAX_X);
 
             auto tile_position = Vector2D<int> { 10 + x_offset, 50 + y_offset };
-            draw_direct_sprite(this->sdl_renderer, selected_tileset, { tile_offset_i, tile_offset_j },
-                { tile_position.x, tile_position.y }, { TILE_SIZE, TILE_SIZE });
+            if (selected_tileset != nullptr) {
+                draw_direct_sprite(this->draw_list, selected_tileset, { tile_offset_i, tile_offset_j },
+                    { tile_position.x, tile_position.y }, { TILE_SIZE, TILE_SIZE });
+            } else {
+                draw_filled_region(this->draw_list,
+                    { tile_position.x, tile_position.y, SCALE_SIZE * TILE_SIZE, SCALE_SIZE * TILE_SIZE }, RGBColor { 250, 200, 150 });
+            }
 
             for (auto const& [di, dj] : std::array<std::tuple<int, int>, 4> { { { +1, 0 }, { -1, 0 }, { 0, +1 }, { 0, -1 } } }) {
-                gout(this->sdl_renderer, this->monogram, { 10 + x_offset + 2 + di, 50 + y_offset + 2 + dj },
+                gout(this->draw_list, this->monogram, { 10 + x_offset + 2 + di, 50 + y_offset + 2 + dj },
                     std::to_string(tile_id), { 255, 255, 255 }, false);
             }
-            gout(this->sdl_renderer, this->monogram, { 10 + x_offset + 2, 50 + y_offset + 2 }, std::to_string(tile_id),
+            gout(this->draw_list, this->monogram, { 10 + x_offset + 2, 50 + y_offset + 2 }, std::to_string(tile_id),
                 DARK_PURPLE_COLOR, false);
 
             // Draw selected tile border (if selected)
@@ -525,6 +569,7 @@ private:
                 Region2D<int> { this->mouse.position.x, this->mouse.position.y, 0, 0 }.as<double>());
             auto tile_is_selected = selected_tile == tile_id;
             if (mouse_is_over || tile_is_selected) {
+                this->submit_drawing();
                 SDL_SetRenderDrawColor(this->sdl_renderer, 255, 255, 255, 255);
                 auto sdl_rect = to_sdl_rect(tile_region);
                 SDL_RenderDrawRect(this->sdl_renderer, &sdl_rect);
@@ -534,11 +579,12 @@ private:
                 }
             }
         }
-        this->tm0.draw();
-        this->tmI.draw();
-        this->left_arrow_button.draw();
-        this->right_arrow_button.draw();
-        this->fill_all_button.draw();
+        this->tm0.draw(this->draw_list);
+        this->tmI.draw(this->draw_list);
+        this->tmT.draw(this->draw_list);
+        this->left_arrow_button.draw(this->draw_list);
+        this->right_arrow_button.draw(this->draw_list);
+        this->fill_all_button.draw(this->draw_list);
     }
 
     SDL_Window* sdl_window;
@@ -546,12 +592,14 @@ private:
     Vector2D<int> camera_offset;
     GameMap map;
     MouseState mouse;
+    DrawList draw_list;
     bool quit;
     int selected_tile;
     int selected_section;
     SDL_Texture* tileset;
     SDL_Texture* interactables_set;
     SDL_Texture* monogram;
+    std::unique_ptr<TilemapChunkCache> tilemap_cache;
     std::string map_filename;
     std::string bottom_panel_message;
 
@@ -565,6 +613,7 @@ private:
     Button fill_all_button;
     Button tm0;
     Button tmI;
+    Button tmT;
 };
 
 int main(int argc, char* argv[])
@@ -4,10 +4,13 @@
 #include <collision/tilemap_collision.hpp>
 #include <collision/character_collision.hpp>
 #include <GameHandler.hpp>
+#include <ReleaseQueue.hpp>
 
 GameScreen::GameScreen(GameHandler& game_handler)
     : game_handler(game_handler)
     , enable_debug(false)
+    , collision_proxies()
+    , character_collision_stats()
 {}
 
 void GameScreen::handle_controller(GameController const& controller)
@@ -29,58 +32,67 @@ void GameScreen::update(double elapsed_time)
     this->game_handler.get_window_shaker().update(elapsed_time);
 }
 
-void GameScreen::render(SDL_Renderer* renderer, double elapsed_time)
+void GameScreen::render(DrawList& draw_list, double elapsed_time)
 {
     // TODO: Get color from level
-    SDL_SetRenderDrawColor(renderer, 89, 157, 84, 255);
-    SDL_RenderClear(renderer);
+    draw_list.clear_screen(RGBColor { 89, 157, 84 });
 
     if (this->enable_debug) {
         this->debug_messages.clear();
-        this->debug_messages.push_back("FPS: " + std::to_string(this->game_handler.get_time_handler().get_fps()));
+        auto const& frame_pacer = this->game_handler.get_frame_pacer();
+        this->debug_messages.push_back("FPS: " + std::to_string(this->game_handler.get_time_handler().get_fps()) + " (target "
+            + std::to_string(frame_pacer.get_target_frame_rate()) + (frame_pacer.is_vsync_enabled() ? ", vsync" : "")
+            + ", pacing error " + std::to_string(frame_pacer.get_pacing_error()) + " ms)");
+        auto const& stats = this->character_collision_stats;
+        this->debug_messages.push_back("Collision pairs: " + std::to_string(stats.pairs_tested) + " tested, "
+            + std::to_string(stats.pairs_collided) + " colliding (" + std::to_string(stats.characters) + " characters)");
     }
 
-    auto const& map = this->active_lvl->get_map();
-    auto const& game_characters = this->active_lvl->get_characters();
+    auto& map = this->active_lvl->get_map();
+    auto const& game_characters = this->active_lvl->get_world().characters;
     auto player = this->player();
+    auto interpolation = this->game_handler.get_time_handler().get_interpolation();
 
     // TODO: Dynamically get background
     // TODO: Parallax effect
     {
-        for (int i = 0; i < ceil(map.width * TILE_SIZE * SCALE_SIZE / 224); ++i) {
+        auto first_background = std::max(0, this->camera_offset.x / 224);
+        auto last_background = std::min(int(ceil(map.width * TILE_SIZE * SCALE_SIZE / 224)),
+            (this->camera_offset.x + SCREEN_WIDTH / SCALE_SIZE) / 224 + 1);
+        for (int i = first_background; i < last_background; ++i) {
             auto offset = Vector2D<int> { 0, 0 };
             auto world_position = Vector2D<int> { 224 * i, 0 };
-            draw_sprite(renderer, assets_registry.forest_background, offset, world_position, Vector2D<int> { 224, 320 }, this->camera_offset);
+            draw_sprite(draw_list, assets_registry.forest_background, offset, world_position, Vector2D<int> { 224, 320 }, this->camera_offset);
         }
     }
 
     auto shake = this->game_handler.get_window_shaker().get_shake();
-    for (int i = 0; i < map.height; ++i) {
-        for (int j = 0; j < map.width; ++j) {
-            // Collision layer
-            {
-                auto tile_id = map.tilemap[i][j];
-                auto offset = Vector2D<int> { TILE_SIZE * (tile_id % 4), TILE_SIZE * int(floor(tile_id / 4)) };
-                auto world_position = Vector2D<int> { TILE_SIZE * j + shake.x, TILE_SIZE * (map.height - i - 1) + shake.y };
-                auto size = Vector2D<int> { TILE_SIZE, TILE_SIZE };
-                draw_sprite(renderer, assets_registry.tileset, offset, world_position, size, this->camera_offset);
-
-                if (this->enable_debug) {
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 40);
-                    if (tile_id != 0) {
-                        auto camera_position = to_camera_position(world_position, size, this->camera_offset);
-                        auto dstrect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * size.x,
-                                                  SCALE_SIZE * size.y };
-                        SDL_RenderFillRect(renderer, &dstrect);
-                    }
+    auto visible_tiles = visible_tiles_region(this->camera_offset, map.width, map.height);
+    // Streamed maps are paged in around the camera, on the simulation thread, which owns the level. The debug overlay
+    // reads these tiles; the render thread pages its own copy (see TilemapChunkCache).
+    map.tilemap.page_in(visible_tiles.x, visible_tiles.x + visible_tiles.w - 1);
+    draw_list.add_tilemap(*this->tilemap_cache, visible_tiles, this->camera_offset, shake);
+    draw_list.flush();
+
+    if (this->enable_debug) {
+        for (int i = visible_tiles.y; i < visible_tiles.y + visible_tiles.h; ++i) {
+            for (int j = visible_tiles.x; j < visible_tiles.x + visible_tiles.w; ++j) {
+                if (map.tilemap(i, j) != 0) {
+                    auto world_position = Vector2D<int> { TILE_SIZE * j + shake.x, TILE_SIZE * (map.height - i - 1) + shake.y };
+                    auto size = Vector2D<int> { TILE_SIZE, TILE_SIZE };
+                    auto camera_position = to_camera_position(world_position, size, this->camera_offset);
+                    auto dstrect = SDL_Rect { camera_position.x, camera_position.y, SCALE_SIZE * size.x,
+                                              SCALE_SIZE * size.y };
+                    draw_list.add_filled(dstrect, SDL_Color { 255, 0, 0, 40 });
                 }
             }
         }
     }
 
     for (auto& game_character : game_characters) {
-        game_character->run_animation(elapsed_time, this->camera_offset);
+        game_character->run_animation(draw_list, elapsed_time, interpolation, this->camera_offset);
     }
+    draw_list.flush();
 
     // HUD
     if (player) {
@@ -89,60 +101,50 @@ void GameScreen::render(SDL_Renderer* renderer, double elapsed_time)
             auto offset = Vector2D<int> { 0, 0 };
             auto size = Vector2D<int> { 66, 34 };
             auto static_camera_position = Vector2D<int> { 10, SCREEN_HEIGHT / SCALE_SIZE - size.y - 10 };
-            draw_static_sprite(renderer, assets_registry.lifebar, offset, static_camera_position, size);
+            draw_static_sprite(draw_list, assets_registry.lifebar, offset, static_camera_position, size);
         }
 
         // Lifebar hearts
         auto offset = Vector2D<int> { 0, 0 };
         auto size = Vector2D<int> { 18, 14 };
-        for (int i = 0; i < player->life; ++i) {
+        for (int i = 0; i < player->health().life; ++i) {
             auto camera_position = Vector2D<int> { 21 + 11 * i, SCREEN_HEIGHT / SCALE_SIZE - size.y - 20 };
-            draw_static_sprite(renderer, assets_registry.lifebar_heart, offset, camera_position, size);
+            draw_static_sprite(draw_list, assets_registry.lifebar_heart, offset, camera_position, size);
         }
+        draw_list.flush();
     }
 
     if (this->enable_debug) {
-        int mousex = 0;
-        int mousey = 0;
-        SDL_GetMouseState(&mousex, &mousey);
-        this->debug_messages.push_back("Mouse (Camera ): " + std::to_string(mousex) + ", " + std::to_string(mousey));
-        auto world_mouse = to_world_position(Vector2D<int> { mousex, mousey }, Vector2D<int> { 0, 0 }, this->camera_offset);
+        auto const& mouse = this->game_handler.get_mouse_position();
+        this->debug_messages.push_back("Mouse (Camera ): " + std::to_string(mouse.x) + ", " + std::to_string(mouse.y));
+        auto world_mouse = to_world_position(mouse, Vector2D<int> { 0, 0 }, this->camera_offset);
         this->debug_messages.push_back("Mouse (World): " + std::to_string(int(world_mouse.x)) + ", " + std::to_string(int(world_mouse.y)));
 
-        auto r = (Uint8)(0);
-        auto g = (Uint8)(0);
-        auto b = (Uint8)(0);
-        auto a = (Uint8)(0);
-        SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
-
         auto debug_area_rect = to_sdl_rect(Region2D<int> { 0, 0, SCREEN_WIDTH, 80 });
 
-        SDL_SetRenderDrawColor(renderer, 65, 60, 70, 220);
-        SDL_RenderFillRect(renderer, &debug_area_rect);
+        draw_list.add_filled(debug_area_rect, SDL_Color { 65, 60, 70, 220 });
         auto text_position = Vector2D<int> { 10, 10 };
         for (auto const& message : this->debug_messages) {
-            gout(renderer, assets_registry.monogram, text_position, message, RGBColor { 100, 240, 100 });
+            gout(draw_list, assets_registry.monogram, text_position, message, RGBColor { 100, 240, 100 });
             text_position.y += 10;
         }
+        draw_list.flush();
 
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 90);
         for (auto& game_character : game_characters) {
             auto const& collision_region = game_character->get_collision_region_information().collision_region;
             auto camera_position = to_camera_position(Vector2D<int> { int(collision_region.x), int(collision_region.y) },
                                                       Vector2D<int> { int(collision_region.w), int(collision_region.h) }, this->camera_offset);
             auto collision_rect = to_sdl_rect(Region2D<int> { camera_position.x, camera_position.y, int(SCALE_SIZE * collision_region.w),
                                                               int(SCALE_SIZE * collision_region.h) });
-            SDL_RenderFillRect(renderer, &collision_rect);
+            draw_list.add_filled(collision_rect, SDL_Color { 255, 0, 0, 90 });
         }
-
-        SDL_SetRenderDrawColor(renderer, r, g, b, a);
     }
 
     // Update camera
     {
         auto position = Vector2D<int> { 0, 0 };
         if (player) {
-            position = player->get_position().as_int();
+            position = player->get_render_position(interpolation).as_int();
         }
 
         auto camera_min_x = 0;
@@ -160,7 +162,13 @@ void GameScreen::render(SDL_Renderer* renderer, double elapsed_time)
 
 void GameScreen::set_active_level(std::unique_ptr<IGameLevel>&& lvl)
 {
+    // The previous level may still be drawn by the render thread. The new tilemap cache is baked by the render thread
+    // too, as its chunks get drawn.
+    release_queue.release(std::move(this->tilemap_cache));
+    release_queue.release(std::move(this->active_lvl));
     this->active_lvl = std::move(lvl);
+    this->tilemap_cache = std::make_unique<TilemapChunkCache>(this->active_lvl->get_map(), assets_registry.tileset);
+    this->active_lvl->get_world().snapshot_transforms();
 
     auto player = this->player();
     if (!player) {
@@ -172,8 +180,8 @@ void GameScreen::set_active_level(std::unique_ptr<IGameLevel>&& lvl)
         transition_animation.register_transition_callback([this]() {
             auto player = this->player();
             player->set_position(100.0, 100.0);
-            player->life = 2;
-            player->is_dead = false;
+            player->health().life = 2;
+            player->health().is_dead = false;
         });
         transition_animation.reset();
     });
@@ -191,11 +199,9 @@ void GameScreen::set_active_level(std::unique_ptr<IGameLevel>&& lvl)
 
 Liv* GameScreen::player()
 {
-    auto& characters = this->active_lvl->get_characters();
-    for (auto& c : characters) {
-        auto* k = dynamic_cast<Liv*>(c.get());
-        if (k != nullptr) {
-            return k;
+    for (auto& c : this->active_lvl->get_world().characters) {
+        if (c->character_type == Liv::CHARACTER_TYPE) {
+            return static_cast<Liv*>(c.get());
         }
     }
     return nullptr;
@@ -203,19 +209,17 @@ Liv* GameScreen::player()
 
 void GameScreen::update_characters(double elapsed_time)
 {
-    auto& game_characters = this->active_lvl->get_characters();
-    for (auto& c : game_characters) {
-        c->update(elapsed_time);
-    }
+    this->active_lvl->get_world().update(elapsed_time);
 }
 
 void GameScreen::compute_collisions()
 {
-    auto& game_characters = this->active_lvl->get_characters();
-    auto& map = this->active_lvl->get_map();
+    auto& world = this->active_lvl->get_world();
+    auto const& static_colliders = this->active_lvl->get_static_colliders();
 
-    for (auto& c : game_characters) {
-        compute_tilemap_collisions(map, c.get(), *this->active_lvl);
-    }
-    compute_characters_collisions(game_characters);
+    world.parallel_for_each_character([&static_colliders](IGameCharacter* c) {
+        compute_tilemap_collisions(static_colliders, c);
+    });
+    this->active_lvl->get_trigger_zones().update(world);
+    this->character_collision_stats = compute_characters_collisions(world, this->collision_proxies);
 }
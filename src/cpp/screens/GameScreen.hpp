@@ -5,6 +5,8 @@
 #include <levels/IGameLevel.hpp>
 #include <characters/IGameCharacter.hpp>
 #include <characters/Liv.hpp>
+#include <TilemapChunkCache.hpp>
+#include <collision/character_collision.hpp>
 #include <memory>
 
 class GameHandler;
@@ -14,7 +16,7 @@ public:
     explicit GameScreen(GameHandler& game_handler);
     void handle_controller(GameController const& controller) override;
     void update(double elapsed_time) override;
-    void render(SDL_Renderer* renderer, double elapsed_time) override;
+    void render(DrawList& draw_list, double elapsed_time) override;
     Liv* player();
     void set_active_level(std::unique_ptr<IGameLevel>&& lvl);
 
@@ -25,8 +27,11 @@ private:
 private:
     GameHandler& game_handler;
     std::unique_ptr<IGameLevel> active_lvl;
+    std::unique_ptr<TilemapChunkCache> tilemap_cache;
     bool enable_debug;
     std::vector<std::string> debug_messages;
+    CollisionProxies collision_proxies;
+    CharacterCollisionStats character_collision_stats;
     Vector2D<int> camera_offset;
 };
 
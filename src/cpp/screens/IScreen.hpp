@@ -4,13 +4,16 @@
 #include <GameController.hpp>
 #include <sdl_wrappers.hpp>
 
+class DrawList;
+
 class IScreen
 {
 public:
     virtual ~IScreen() = 0;
     virtual void handle_controller(GameController const& controller) = 0;
     virtual void update(double elapsed_time) = 0;
-    virtual void render(SDL_Renderer* renderer, double elapsed_time) = 0;
+    // Records the screen's drawing, on the simulation thread
+    virtual void render(DrawList& draw_list, double elapsed_time) = 0;
 };
 
 inline IScreen::~IScreen() {}
@@ -65,28 +65,27 @@ void TitleScreen::update(double elapsed_time)
     }
 }
 
-void TitleScreen::render(SDL_Renderer* renderer, double elapsed_time)
+void TitleScreen::render(DrawList& draw_list, double elapsed_time)
 {
-    SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-    SDL_RenderClear(renderer);
+    draw_list.clear_screen(RGBColor { 50, 50, 50 });
 
     if (this->state == TitleScreen::State::SHOWING_TITLE) {
         auto text = "Pigs Game"s;
         auto text_position = Vector2D<int> { (SCREEN_WIDTH - gstr_width(text)) / 2, SCREEN_HEIGHT / 2 };
-        gout(renderer, assets_registry.monogram, text_position, text, RGBColor { 255, 255, 255 });
+        gout(draw_list, assets_registry.monogram, text_position, text, RGBColor { 255, 255, 255 });
     } else if (this->state == TitleScreen::State::SHOWING_MAIN_MENU) {
         // TODO: Make actual buttons
         {
             auto text = "Start new game"s;
             auto text_color = (this->selected_menu == TitleScreen::SelectedMenu::START_GAME) ? RGBColor { 0, 150, 0 } : RGBColor { 255, 255, 255 };
             auto text_position = Vector2D<int> { (SCREEN_WIDTH - gstr_width(text)) / 2, SCREEN_HEIGHT / 2 };
-            gout(renderer, assets_registry.monogram, text_position, text, text_color);
+            gout(draw_list, assets_registry.monogram, text_position, text, text_color);
         }
         {
             auto text = "Exit"s;
             auto text_color = (this->selected_menu == TitleScreen::SelectedMenu::EXIT_GAME) ? RGBColor { 0, 150, 0 } : RGBColor { 255, 255, 255 };
             auto text_position = Vector2D<int> { (SCREEN_WIDTH - gstr_width(text)) / 2, SCREEN_HEIGHT / 2 + 40};
-            gout(renderer, assets_registry.monogram, text_position, text, text_color);
+            gout(draw_list, assets_registry.monogram, text_position, text, text_color);
         }
     }
 }
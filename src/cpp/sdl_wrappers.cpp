@@ -1,8 +1,20 @@
 #include <sdl_wrappers.hpp>
+#include <AssetPack.hpp>
 #include <logging.hpp>
 
 SDL_Texture* load_media(std::string const& filename, SDL_Renderer* renderer)
 {
+    if (auto entry = asset_pack.find_image(filename)) {
+        auto* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, entry->width, entry->height);
+        if (texture == nullptr) {
+            warn("Unable to create texture from asset pack. SDL Error: "s + SDL_GetError());
+            return nullptr;
+        }
+        SDL_UpdateTexture(texture, nullptr, entry->data.data(), 4 * entry->width);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        return texture;
+    }
+
     auto* surface = IMG_Load(filename.c_str());
     if (surface == nullptr) {
         warn("Unable to load image. SDL Error: "s + SDL_GetError());
@@ -20,6 +32,10 @@ SDL_Handler::SDL_Handler()
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         err("SDL could not be initialized! SDL Error: "s + SDL_GetError());
     }
+    // Initialized upfront as IMG_Load would otherwise lazily do it from the asset decoding threads
+    if ((IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG) != IMG_INIT_PNG) {
+        err("Failed to initialize PNG support: "s + IMG_GetError());
+    }
     if (TTF_Init() != 0) {
         err("Failed to initialize TTF library");
     }
@@ -27,5 +43,6 @@ SDL_Handler::SDL_Handler()
 
 SDL_Handler::~SDL_Handler() {
     TTF_Quit();
+    IMG_Quit();
     SDL_Quit();
 }
@@ -5,8 +5,22 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 
+#include <Vector2D.hpp>
 #include <string>
 
+// A sprite sheet image placed at `origin` inside `texture` (the whole texture, or a region of an atlas page)
+struct SpriteSheet {
+    SpriteSheet(SDL_Texture* texture = nullptr, Vector2D<int> const& origin = { 0, 0 })
+        : texture(texture)
+        , origin(origin)
+    {
+    }
+
+    SDL_Texture* texture;
+    Vector2D<int> origin;
+};
+
+// Loads an image from the asset pack when it is there, otherwise from the loose file
 SDL_Texture* load_media(std::string const& filename, SDL_Renderer* renderer);
 
 struct SDL_Handler